@@ -2,6 +2,9 @@
 #include <eosio/eosio.hpp>
 #include <eosio/asset.hpp>
 #include <eosio/crypto.hpp>
+#include <map>
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 using namespace eosio;
@@ -22,9 +25,22 @@ using namespace eosio;
  * ----------------
  */
 
+// Network selection happens at build time, pass one of these to the compiler:
+//   -DTOTEMS_NETWORK_JUNGLE     (default)
+//   -DTOTEMS_NETWORK_LOCAL_TEST (local VM tests, no proxy mod contract)
+#if (defined(TOTEMS_NETWORK_JUNGLE) + defined(TOTEMS_NETWORK_LOCAL_TEST)) > 1
+#error "Only one TOTEMS_NETWORK_* may be defined"
+#endif
+// Vaulta mainnet gets its profile once the protocol's accounts there are known
+#ifdef TOTEMS_NETWORK_VAULTA
+#error "No Vaulta network profile yet: its totems, market and proxy mod accounts are not known"
+#endif
+
 // Use these for your on_notify instead of hardcoding them so that
-// when this contract changes networks (jungle -> vaulta) you can just update your library file.
+// when this contract changes networks you only change the build flag.
 // example: [[eosio::on_notify(TOTEMS_TRANSFER_NOTIFY)]]
+// (These have to stay string literal macros for the attribute. Every network currently uses
+// the same totems account; give a network its own block here if that ever changes.)
 #define TOTEMS_TRANSFER_NOTIFY "totemstotems::transfer"
 #define TOTEMS_MINT_NOTIFY "totemstotems::mint"
 #define TOTEMS_BURN_NOTIFY "totemstotems::burn"
@@ -35,10 +51,36 @@ using namespace eosio;
 
 namespace totems {
 
-	// Smart contract constants, make sure you get the right library for your network!
-	static const name MARKET_CONTRACT = "modsmodsmods"_n;
-	static const name TOTEMS_CONTRACT = "totemstotems"_n;
-	static const name PROXY_MOD_CONTRACT = "totemodproxy"_n;
+	/* ---------------- NETWORKS ---------------- */
+
+	// Each profile is the full set of accounts a mod talks to on that network,
+	// plus which optional contracts exist there so lookups into them compile away.
+	namespace networks {
+		struct jungle {
+			static constexpr name market = "modsmodsmods"_n;
+			static constexpr name totems = "totemstotems"_n;
+			static constexpr name proxy_mods = "totemodproxy"_n;
+			static constexpr bool has_proxy_mods = true;
+		};
+
+		struct local_test {
+			static constexpr name market = "modsmodsmods"_n;
+			static constexpr name totems = "totemstotems"_n;
+			static constexpr name proxy_mods = "totemodproxy"_n;
+			static constexpr bool has_proxy_mods = false;
+		};
+	}
+
+#if defined(TOTEMS_NETWORK_LOCAL_TEST)
+	using network = networks::local_test;
+#else
+	using network = networks::jungle;
+#endif
+
+	// Smart contract constants for the network selected above
+	static constexpr name MARKET_CONTRACT = network::market;
+	static constexpr name TOTEMS_CONTRACT = network::totems;
+	static constexpr name PROXY_MOD_CONTRACT = network::proxy_mods;
 
 	/* ---------------- MOD MARKET ---------------- */
 
@@ -126,7 +168,7 @@ namespace totems {
 	    time_point_sec updated_at;
 
 	    bool has_hook(const name& hook_name) const {
-	        return std::find(hooks.begin(), hooks.end(), hook_name) != hooks.end();
+	        return hooks.count(hook_name) > 0;
 	    }
 
 	    uint64_t primary_key() const { return contract.value; }
@@ -144,6 +186,123 @@ namespace totems {
 	    return *mod;
 	}
 
+	/***
+	  * Read-only view over a raw `mods` row that decodes only what hook resolution needs.
+	  * `get_mod` copies the whole Mod (markdown, details strings, hooks set, every required action);
+	  * this keeps the packed row and walks it in place:
+	  *   - `has_hook` binary searches the packed hooks (a std::set serializes sorted)
+	  *   - `append_required_actions` skips other hooks' entries by length and unpacks only the
+	  *     matching hook's actions, straight into the caller's vector
+	  * The markdown and other details strings are never decoded.
+	  * Field order must match `Mod` above.
+	  */
+	class mod_view {
+	  public:
+	    // Loads the raw row for a mod, or nullopt if it isn't published
+	    static std::optional<mod_view> find(const name& contract) {
+	        using namespace internal_use_do_not_use;
+	        int32_t itr = db_find_i64(MARKET_CONTRACT.value, MARKET_CONTRACT.value, "mods"_n.value, contract.value);
+	        if (itr < 0) return std::nullopt;
+
+	        mod_view view;
+	        view.raw_.resize(db_get_i64(itr, nullptr, 0));
+	        db_get_i64(itr, view.raw_.data(), view.raw_.size());
+
+	        datastream<const char*> ds(view.raw_.data(), view.raw_.size());
+	        skip(ds, sizeof(uint64_t) * 3); // contract, seller, price
+	        for (int i = 0; i < 6; ++i) skip_bytes(ds); // ModDetails strings
+	        skip(ds, sizeof(bool) + sizeof(int64_t)); // is_minter, score
+
+	        unsigned_int hook_count;
+	        ds >> hook_count;
+	        view.hooks_offset_ = ds.tellp();
+	        view.hook_count_ = hook_count.value;
+	        // Divide rather than multiply, size_t is 32 bits on wasm
+	        check(view.hook_count_ <= ds.remaining() / sizeof(uint64_t), "Malformed mod row");
+	        ds.skip(sizeof(uint64_t) * view.hook_count_);
+	        view.required_offset_ = ds.tellp();
+	        return view;
+	    }
+
+	    bool has_hook(const name& hook) const {
+	        uint32_t lo = 0, hi = hook_count_;
+	        while (lo < hi) {
+	            uint32_t mid = lo + (hi - lo) / 2;
+	            uint64_t value;
+	            memcpy(&value, raw_.data() + hooks_offset_ + mid * sizeof(uint64_t), sizeof(value));
+	            if (value == hook.value) return true;
+	            if (value < hook.value) lo = mid + 1;
+	            else hi = mid;
+	        }
+	        return false;
+	    }
+
+	    // Appends the required actions registered for `hook` (if any) to `out`
+	    void append_required_actions(const name& hook, std::vector<RequiredAction>& out) const {
+	        datastream<const char*> ds(raw_.data() + required_offset_, raw_.size() - required_offset_);
+	        unsigned_int hook_entries;
+	        ds >> hook_entries;
+	        for (uint32_t i = 0; i < hook_entries.value; ++i) {
+	            name entry_hook;
+	            unsigned_int action_count;
+	            ds >> entry_hook >> action_count;
+	            if (entry_hook != hook) {
+	                for (uint32_t a = 0; a < action_count.value; ++a) skip_required_action(ds);
+	                continue;
+	            }
+	            // The count comes from the row, so bound it by what the row can hold before
+	            // reserving: a packed action is at least contract + action + two empty varuints
+	            check(action_count.value <= ds.remaining() / (sizeof(uint64_t) * 2 + 2), "Malformed mod row");
+	            out.reserve(out.size() + action_count.value);
+	            for (uint32_t a = 0; a < action_count.value; ++a) {
+	                out.emplace_back();
+	                ds >> out.back();
+	            }
+	        }
+	    }
+
+	  private:
+	    std::vector<char> raw_;
+	    size_t hooks_offset_ = 0;
+	    uint32_t hook_count_ = 0;
+	    size_t required_offset_ = 0;
+
+	    // datastream::skip doesn't bounds check, and once past the end the stream's own reads
+	    // stop catching it, so every skip goes through here
+	    static void skip(datastream<const char*>& ds, size_t len) {
+	        check(len <= ds.remaining(), "Malformed mod row");
+	        ds.skip(len);
+	    }
+
+	    // Skips a string / vector<char>
+	    static void skip_bytes(datastream<const char*>& ds) {
+	        unsigned_int len;
+	        ds >> len;
+	        skip(ds, len.value);
+	    }
+
+	    static void skip_optional_u64(datastream<const char*>& ds) {
+	        bool has_value;
+	        ds >> has_value;
+	        if (has_value) skip(ds, sizeof(uint64_t));
+	    }
+
+	    static void skip_required_action(datastream<const char*>& ds) {
+	        skip(ds, sizeof(uint64_t) * 2); // contract, action
+	        unsigned_int field_count;
+	        ds >> field_count;
+	        for (uint32_t f = 0; f < field_count.value; ++f) {
+	            skip_bytes(ds); // param
+	            skip(ds, sizeof(uint8_t)); // type
+	            skip_bytes(ds); // data
+	            skip(ds, sizeof(uint16_t) * 2); // offset, size
+	            skip_optional_u64(ds); // min
+	            skip_optional_u64(ds); // max
+	        }
+	        skip_bytes(ds); // purpose
+	    }
+	};
+
 	/* ---------------- TOTEMS ---------------- */
 	// Balance table for each account
 	struct [[eosio::table]] Balance {
@@ -282,21 +441,77 @@ namespace totems {
 	// scoped to ticker (symbol_code)
     typedef eosio::multi_index<"licenses"_n, License> license_table;
 
+	/***
+	  * Checks that a mod is licensed for a totem, either directly on the totems contract
+	  * or through the proxy mod contract on networks that have one.
+	  * @param ticker - The symbol code of the totem/ticker
+	  * @param mod - The mod contract to check
+	  */
+	template <typename Network = network>
 	void check_license(const symbol_code& ticker, const name& mod){
 		{
-			license_table licenses(TOTEMS_CONTRACT, ticker.raw());
+			license_table licenses(Network::totems, ticker.raw());
 			if(licenses.find(mod.value) != licenses.end()) return;
 		}
-		{
-			if(is_account(PROXY_MOD_CONTRACT)){
-				license_table licenses(PROXY_MOD_CONTRACT, ticker.raw());
-				if(licenses.find(mod.value) != licenses.end()) return;
-			}
+		// No is_account probe needed: a lookup into a table that was never written is just a miss
+		if constexpr (Network::has_proxy_mods) {
+			license_table licenses(Network::proxy_mods, ticker.raw());
+			if(licenses.find(mod.value) != licenses.end()) return;
 		}
 
 		check(false, "Mod is not licensed for this totem: " + mod.to_string());
 	}
 
+	/***
+	  * Per-action lookup context.
+	  * Every free helper above builds a fresh multi_index, so looking up the same totem,
+	  * balance or license twice in one action costs two rounds of db intrinsics and decoding.
+	  * A context keeps the table handles (and with them multi_index's decoded row cache) alive,
+	  * so repeated lookups are served from memory and rows are returned by pointer, not copied.
+	  * Create one at the top of an action and pass it down, pointers are valid while it lives.
+	  *
+	  * Balances are read as they were when first looked up: don't reuse a context to read a
+	  * balance after something in the same action changed it (inline actions run afterwards, so
+	  * `transfer` and friends are fine).
+	  */
+	class context {
+	  public:
+	    /***
+	      * @param code - The symbol code of the totem/ticker
+	      * @return The totem, or nullptr if it doesn't exist
+	      */
+	    const Totem* get_totem(const symbol_code& code) {
+	        auto it = totems_.find(code.raw());
+	        return it == totems_.end() ? nullptr : &*it;
+	    }
+
+	    /***
+	      * @param owner - The account owning the balance
+	      * @param ticker - The symbol of the totem/ticker
+	      * @return The asset balance of the totem for the account or 0 if none
+	      */
+	    asset get_balance(const name& owner, const symbol& ticker) {
+	        auto& balances = balances_.try_emplace(owner, network::totems, owner.value).first->second;
+	        auto it = balances.find(ticker.code().raw());
+	        return it == balances.end() ? asset{0, ticker} : it->balance;
+	    }
+
+	    // Same as totems::check_license, but each (ticker, mod) pair is only checked once
+	    void check_license(const symbol_code& ticker, const name& mod) {
+	        for (const auto& [licensed_ticker, licensed_mod] : licensed_) {
+	            if (licensed_ticker == ticker && licensed_mod == mod) return;
+	        }
+	        totems::check_license(ticker, mod);
+	        licensed_.emplace_back(ticker, mod);
+	    }
+
+	  private:
+	    totems_table totems_{network::totems, network::totems.value};
+	    // std::map so the tables never move (cached rows point back at their table)
+	    std::map<name, balances_table> balances_;
+	    std::vector<std::pair<symbol_code, name>> licensed_;
+	};
+
 	/***
 	  * This is really only useful internally for market/totem I think, but I'm leaving it here for now
 	  * since all the structs are here and I'm not sure if it's useful for others yet. It's doubtful it is though.
@@ -304,19 +519,10 @@ namespace totems {
 	std::vector<RequiredAction> get_required_actions(const name& hook, const std::vector<name>& mod_names) {
 	    std::vector<RequiredAction> required_actions;
 	    for (const auto& mod_name : mod_names) {
-	        auto mod = get_mod(mod_name);
+	        auto mod = mod_view::find(mod_name);
 	        check(mod.has_value(), "Mod is not published in market: " + mod_name.to_string());
-	        check(mod.value().has_hook(hook), "Mod does not support required hook: " + hook.to_string());
-	        // TODO: More performant way to do this?
-	        for (const auto& req_hook : mod.value().required_actions) {
-	            if (req_hook.hook == hook) {
-	                required_actions.insert(
-	                    required_actions.end(),
-	                    req_hook.actions.begin(),
-	                    req_hook.actions.end()
-	                );
-	            }
-	        }
+	        check(mod->has_hook(hook), "Mod does not support required hook: " + hook.to_string());
+	        mod->append_required_actions(hook, required_actions);
 	    }
 	    return required_actions;
 	}
@@ -0,0 +1,83 @@
+#pragma once
+#include <eosio/eosio.hpp>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Action-scoped Bump Arena (opt-in)
+ * ----------------
+ * Build with -DMIRROR_ARENA to serve every `operator new` (std::string, std::vector, decoded
+ * Totem rows, packed inline action data, ...) from a static region instead of the CDT heap.
+ *
+ * Every action runs in a freshly instantiated module, so the arena is back to empty at the start
+ * of each action without doing anything. Within an action nothing is ever freed: allocation is a
+ * pointer bump and `delete` is a no-op. The region is zero-initialized static data, so it is part
+ * of the module's initial memory and never needs a memory grow. Allocations that don't fit fall
+ * back to the regular heap.
+ *
+ *   -DMIRROR_ARENA_SIZE=<bytes>   region size (default 64 KiB)
+ *   -DMIRROR_ARENA_REPORT         print `arena_peak_bytes=<n> arena_overflow_bytes=<m>` at the end of
+ *                                 each action: the most arena bytes in use at once, and the bytes
+ *                                 that didn't fit and went to the regular heap (0 when the region
+ *                                 is big enough)
+ * ----------------
+ */
+
+#ifdef MIRROR_ARENA
+
+#ifndef MIRROR_ARENA_SIZE
+#define MIRROR_ARENA_SIZE (64 * 1024)
+#endif
+
+namespace mirror_arena {
+
+	alignas(16) inline char region[MIRROR_ARENA_SIZE];
+	inline size_t used = 0;
+	inline size_t peak = 0;
+	// Requested bytes that didn't fit in the region; peak + overflow is the action's heap demand
+	inline size_t overflow = 0;
+
+	inline void* allocate(size_t size) {
+	    size_t aligned = (size + 15) & ~size_t(15);
+	    if (aligned > MIRROR_ARENA_SIZE - used) {
+	        overflow += aligned;
+	        return malloc(size);
+	    }
+	    void* ptr = region + used;
+	    used += aligned;
+	    if (used > peak) peak = used;
+	    return ptr;
+	}
+
+	inline void release(void* ptr) {
+	    char* p = static_cast<char*>(ptr);
+	    if (p >= region && p < region + MIRROR_ARENA_SIZE) return;
+	    free(ptr);
+	}
+
+	// Prints the action's peak arena usage when it goes out of scope
+	struct report_scope {
+	    ~report_scope() {
+	        eosio::print("arena_peak_bytes=", peak, " arena_overflow_bytes=", overflow, "\n");
+	    }
+	};
+
+}  // namespace mirror_arena
+
+void* operator new(size_t size) { return mirror_arena::allocate(size); }
+void* operator new[](size_t size) { return mirror_arena::allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return mirror_arena::allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return mirror_arena::allocate(size); }
+void operator delete(void* ptr) noexcept { mirror_arena::release(ptr); }
+void operator delete[](void* ptr) noexcept { mirror_arena::release(ptr); }
+void operator delete(void* ptr, size_t) noexcept { mirror_arena::release(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { mirror_arena::release(ptr); }
+
+#endif  // MIRROR_ARENA
+
+// Put at the top of each action; expands to nothing unless reporting is enabled
+#if defined(MIRROR_ARENA) && defined(MIRROR_ARENA_REPORT)
+#define ARENA_REPORT_SCOPE() mirror_arena::report_scope arena_report_scope_
+#else
+#define ARENA_REPORT_SCOPE()
+#endif
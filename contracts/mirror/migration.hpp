@@ -0,0 +1,94 @@
+#pragma once
+#include <eosio/binary_extension.hpp>
+#include <eosio/eosio.hpp>
+using namespace eosio;
+
+/*
+ * Versioned Table Migrations
+ * ----------------
+ * Lets a table change its row layout without a one-shot rewrite (which stops fitting in a
+ * transaction's CPU limit once a table has a few thousand rows).
+ *
+ * Rules for a migratable row:
+ *   - the last fields are `binary_extension`s, starting with `binary_extension<uint8_t> row_version`,
+ *     so rows written by older code still decode (missing extensions read as empty, version 0)
+ *   - new fields are only ever appended, also as `binary_extension`
+ *   - whenever code writes a row, every extension up to its newest field must have a value,
+ *     otherwise later fields would be read from the wrong offset
+ *
+ * `migration::step` then upgrades rows in bounded batches, keeping its cursor in the `migrations`
+ * table, while everything else keeps reading and writing mixed-version rows.
+ * ----------------
+ */
+
+namespace migration {
+
+	// Progress of one table's migration, keyed by table name
+	struct [[eosio::table]] MigrationState {
+	    name table;
+	    // Every row is at least at this version
+	    uint8_t version = 0;
+	    // Version the in-flight migration is upgrading to
+	    uint8_t target = 0;
+	    // Primary key to resume from
+	    uint64_t cursor = 0;
+
+	    uint64_t primary_key() const { return table.value; }
+	};
+
+	typedef eosio::multi_index<"migrations"_n, MigrationState> migrations_table;
+
+	template <typename Row>
+	uint8_t row_version(const Row& row) {
+	    return row.row_version.has_value() ? row.row_version.value() : 0;
+	}
+
+	/***
+	  * Upgrades up to `limit` rows of `table` to version `target`, resuming where the last call stopped.
+	  * `upgrade(row, from_version)` must fill in every field added after `from_version`;
+	  * the engine sets `row_version` afterwards. Rows already at `target` are skipped but count
+	  * against `limit`, so every call has a bounded cost.
+	  * @param self - The contract, owns the `migrations` table and pays for its row
+	  * @param table_name - Key of this table's progress in the `migrations` table
+	  * @return The number of rows upgraded
+	  */
+	template <typename Table, typename Upgrade>
+	uint32_t step(const name& self, const name& table_name, Table& table, uint8_t target, uint32_t limit, Upgrade&& upgrade) {
+	    check(limit > 0, "Limit must be positive");
+
+	    migrations_table migrations(self, self.value);
+	    auto state = migrations.find(table_name.value);
+	    if (state == migrations.end()) {
+	        state = migrations.emplace(self, [&](auto& row) {
+	            row.table = table_name;
+	        });
+	    }
+	    check(state->version < target, "Migration already complete");
+
+	    // A new target restarts the walk from the first row
+	    uint64_t cursor = state->target == target ? state->cursor : 0;
+
+	    uint32_t visited = 0;
+	    uint32_t upgraded = 0;
+	    auto it = table.lower_bound(cursor);
+	    for (; it != table.end() && visited < limit; ++it, ++visited) {
+	        uint8_t from = row_version(*it);
+	        if (from >= target) continue;
+	        table.modify(it, same_payer, [&](auto& row) {
+	            upgrade(row, from);
+	            row.row_version.emplace(target);
+	        });
+	        upgraded++;
+	    }
+
+	    bool finished = it == table.end();
+	    uint64_t next = finished ? 0 : it->primary_key();
+	    migrations.modify(state, same_payer, [&](auto& row) {
+	        row.target = target;
+	        row.cursor = next;
+	        if (finished) row.version = target;
+	    });
+	    return upgraded;
+	}
+
+}  // namespace migration
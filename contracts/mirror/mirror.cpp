@@ -3,16 +3,46 @@
 #include <eosio/transaction.hpp>
 
 #include "../library/totems.hpp"
+#include "arena.hpp"
+#include "migration.hpp"
 using namespace eosio;
 
+// Smallest non-creator deposit the ledger records, in whole base tokens. Every recorded
+// depositor costs the contract a `deposits` row, so smaller transfers stay untracked (and
+// back the creator's next mint) instead of letting dust exhaust the contract's RAM.
+#ifndef MIRROR_MIN_DEPOSIT
+#define MIRROR_MIN_DEPOSIT 1
+#endif
+
 CONTRACT mirror : public contract {
    public:
     using contract::contract;
 
+    // Current Pairing layout. Bump it when appending a field, and handle the
+    // new field in `upgrade_pairing` so `migrate` can bring older rows up to date.
+    static constexpr uint8_t PAIRING_VERSION = 3;
+
+    // Per-pairing activity counters, kept in the pairing row itself so updating them
+    // costs no extra db operations. Build with -DMIRROR_NO_STATS to stop updating them.
+    struct PairingStats {
+        uint64_t mints = 0;
+        uint64_t redemptions = 0;
+        // Cumulative volumes, in base token units
+        int64_t minted = 0;
+        int64_t redeemed = 0;
+        time_point_sec last_activity;
+    };
+
     struct [[eosio::table]] Pairing {
         symbol_code synth_ticker;
         symbol_code base_ticker;
         asset base_locked;
+        // Everything from here on is a binary_extension (see migration.hpp), so rows of any
+        // older version still decode and mint/redemptions work while a migration is running.
+        binary_extension<uint8_t> row_version;
+        // v2
+        binary_extension<PairingStats> stats;
+        // v3 added no field: a v3 row is listed in its creator's `creatorpairs` view
         uint64_t primary_key() const { return synth_ticker.raw(); }
         uint64_t by_base() const { return base_ticker.raw(); }
     };
@@ -20,14 +50,91 @@ CONTRACT mirror : public contract {
     typedef eosio::multi_index<"pairings"_n, Pairing,
         indexed_by<"bybase"_n, const_mem_fun<Pairing, uint64_t, &Pairing::by_base>>> pairings_table;
 
+    // Declared here so the ABI exposes migration progress
+    typedef migration::migrations_table migrations_table;
+
+    // Base tokens sent in by anyone other than the creator, per depositor.
+    // Scoped to the base ticker. These are kept out of the mint delta until the
+    // depositor takes them back (`refund`) or the creator claims them (`sweep`).
+    struct [[eosio::table]] Deposit {
+        name depositor;
+        asset amount;
+        uint64_t primary_key() const { return depositor.value; }
+    };
+
+    typedef eosio::multi_index<"deposits"_n, Deposit> deposits_table;
+
+    // Sum of all recorded deposits for a base, so `mint` doesn't have to walk the ledger
+    struct [[eosio::table]] Unclaimed {
+        symbol_code base_ticker;
+        asset total;
+        uint64_t primary_key() const { return base_ticker.raw(); }
+    };
+
+    typedef eosio::multi_index<"unclaimed"_n, Unclaimed> unclaimed_table;
+
+    // Creator-scoped view of `pairings`, so one creator's pairings can be listed without
+    // scanning everyone's. Scoped to the creator, written once by `setup` (or `migrate`
+    // for pairings created before it existed) since a pairing never moves.
+    struct [[eosio::table]] CreatorPairing {
+        symbol_code synth_ticker;
+        symbol_code base_ticker;
+        uint64_t primary_key() const { return synth_ticker.raw(); }
+    };
+
+    typedef eosio::multi_index<"creatorpairs"_n, CreatorPairing> creator_pairings_table;
+
+    // Per-creator aggregates
+    struct [[eosio::table]] Creator {
+        name creator;
+        uint32_t pairings = 0;
+        uint64_t primary_key() const { return creator.value; }
+    };
+
+    typedef eosio::multi_index<"creators"_n, Creator> creators_table;
+
+    struct CreatorSummary {
+        name creator;
+        uint32_t pairing_count = 0;
+        std::vector<Pairing> pairings;
+        // Sum of base_locked over the creator's pairings, one entry per base
+        std::vector<asset> locked_per_base;
+    };
+
+    // Bytes per exported pairing: synth_ticker, base_ticker, base_locked (amount, symbol),
+    // i.e. the Pairing layout without its binary extensions
+    static constexpr size_t EXPORT_RECORD_SIZE = 32;
+
+    // Most pairings one export page returns, whatever `limit` asks for; a larger limit gets
+    // a full page with `more` set, so the caller just follows next_cursor
+    static constexpr uint32_t MAX_EXPORT_ROWS = 5000;
+
+    struct ExportPage {
+        // EXPORT_RECORD_SIZE bytes per pairing, in primary key order
+        std::vector<char> records;
+        // Sum of base_locked per base over this page only, so totals of all pages add up
+        std::vector<asset> locked_per_base;
+        // Cursor of the next page when `more` is set
+        uint64_t next_cursor = 0;
+        bool more = false;
+    };
+
     [[eosio::action]]
     void setup(const symbol& synth_ticker, const symbol& base_ticker) {
-        auto base_totem = totems::get_totem(base_ticker.code());
-        check(base_totem.has_value(), "Base totem does not exist");
-        auto synth_totem = totems::get_totem(synth_ticker.code());
-        check(synth_totem.has_value(), "Synth totem does not exist");
+        ARENA_REPORT_SCOPE();
+        totems::context ctx;
+        auto base_totem = ctx.get_totem(base_ticker.code());
+        check(base_totem != nullptr, "Base totem does not exist");
+        auto synth_totem = ctx.get_totem(synth_ticker.code());
+        check(synth_totem != nullptr, "Synth totem does not exist");
 
+#ifdef MIRROR_REGISTRY
+        // Factory mode: this account is one shard of a registry, which has already checked
+        // the creator's authority and routed this synth here (see contracts/registry)
+        require_auth(name(MIRROR_REGISTRY));
+#else
         require_auth(base_totem->creator);
+#endif
         check(base_totem->creator == synth_totem->creator, "Base and synth totems must have the same creator");
         check(synth_ticker.precision() == base_ticker.precision(), "Synth and base tickers must have the same precision");
         check(synth_ticker != base_ticker, "Synth and base tickers must be different");
@@ -40,13 +147,80 @@ CONTRACT mirror : public contract {
             row.synth_ticker = synth_ticker.code();
             row.base_ticker = base_ticker.code();
             row.base_locked = asset{0, base_ticker};
+            row.row_version.emplace(PAIRING_VERSION);
+            row.stats.emplace();
         });
+        index_pairing(synth_totem->creator, synth_ticker.code(), base_ticker.code());
+    }
+
+    // One creator's pairings and exposure; reads only that creator's rows
+    [[eosio::action, eosio::read_only]]
+    CreatorSummary creatorinfo(const name& creator) {
+        ARENA_REPORT_SCOPE();
+        CreatorSummary summary{creator};
+        creators_table creators(get_self(), get_self().value);
+        auto aggregate = creators.find(creator.value);
+        if (aggregate == creators.end()) {
+            return summary;
+        }
+        summary.pairing_count = aggregate->pairings;
+
+        pairings_table pairings(get_self(), get_self().value);
+        creator_pairings_table view(get_self(), creator.value);
+        for (const auto& entry : view) {
+            const auto& pairing = pairings.get(entry.synth_ticker.raw(), "Pairing missing for creator view row");
+            summary.pairings.push_back(pairing);
+            add_locked(summary.locked_per_base, pairing.base_locked);
+        }
+        return summary;
+    }
+
+    // Bulk export for indexers: up to `limit` (at most MAX_EXPORT_ROWS) pairings from primary key
+    // `cursor` (0 to start), as fixed-size records instead of ABI-decoded JSON. See tools/export_decoder.
+    [[eosio::action("export"), eosio::read_only]]
+    ExportPage export_page(const uint64_t& cursor, const uint32_t& limit) {
+        ARENA_REPORT_SCOPE();
+        check(limit > 0, "Limit must be positive");
+        const uint32_t rows = std::min(limit, MAX_EXPORT_ROWS);
+
+        ExportPage page;
+        page.records.reserve(rows * EXPORT_RECORD_SIZE);
+        pairings_table pairings(get_self(), get_self().value);
+        auto it = pairings.lower_bound(cursor);
+        for (uint32_t count = 0; it != pairings.end() && count < rows; ++it, ++count) {
+            uint64_t record[4] = {
+                it->synth_ticker.raw(),
+                it->base_ticker.raw(),
+                uint64_t(it->base_locked.amount),
+                it->base_locked.symbol.raw(),
+            };
+            const char* bytes = reinterpret_cast<const char*>(record);
+            page.records.insert(page.records.end(), bytes, bytes + EXPORT_RECORD_SIZE);
+            add_locked(page.locked_per_base, it->base_locked);
+        }
+
+        if (it != pairings.end()) {
+            page.next_cursor = it->primary_key();
+            page.more = true;
+        }
+        return page;
+    }
+
+    // Permissionless: upgrades up to `limit` pairings to PAIRING_VERSION per call
+    [[eosio::action]]
+    void migrate(const uint32_t& limit) {
+        ARENA_REPORT_SCOPE();
+        pairings_table pairings(get_self(), get_self().value);
+        migration::step(get_self(), "pairings"_n, pairings, PAIRING_VERSION, limit,
+                        [&](Pairing& row, uint8_t from) { upgrade_pairing(row, from); });
     }
 
     [[eosio::action]]
     void mint(const name& mod, const name& minter, const asset& quantity, const asset& payment, const std::string& memo) {
+        ARENA_REPORT_SCOPE();
         check(get_sender() == totems::TOTEMS_CONTRACT, "mint action can only be called by totems contract");
-        totems::check_license(quantity.symbol.code(), get_self());
+        totems::context ctx;
+        ctx.check_license(quantity.symbol.code(), get_self());
         check(payment.amount == 0, "Mirror mod does not accept payment");
 
         symbol synth_sym = quantity.symbol;
@@ -55,8 +229,8 @@ CONTRACT mirror : public contract {
         auto pair_itr = pairings.find(synth_sym.code().raw());
         check(pair_itr != pairings.end(), "No pairing exists for this synth ticker");
 
-        auto synth_totem = totems::get_totem(synth_sym.code());
-        check(synth_totem.has_value(), "Synth totem does not exist");
+        auto synth_totem = ctx.get_totem(synth_sym.code());
+        check(synth_totem != nullptr, "Synth totem does not exist");
         check(minter == synth_totem->creator, "Only the creator can mint synth tokens");
 
         symbol base_sym = symbol(pair_itr->base_ticker, synth_sym.precision());
@@ -71,12 +245,19 @@ CONTRACT mirror : public contract {
             total_tracked += it->base_locked.amount;
         }
 
-        asset actual_balance = totems::get_balance(get_self(), base_sym);
-        int64_t delta = actual_balance.amount - total_tracked;
+        // Deposits recorded in the ledger belong to their depositors, not to this mint
+        asset actual_balance = ctx.get_balance(get_self(), base_sym);
+        int64_t delta = actual_balance.amount - total_tracked - unclaimed_deposits(pair_itr->base_ticker);
         check(delta > 0, "No new base tokens deposited for minting synths");
 
         pairings.modify(pair_itr, get_self(), [&](auto& row) {
             row.base_locked += asset{delta, base_sym};
+#ifndef MIRROR_NO_STATS
+            auto& stats = current_stats(row);
+            stats.mints++;
+            stats.minted += delta;
+            stats.last_activity = current_time_point();
+#endif
         });
 
         totems::transfer(
@@ -87,11 +268,39 @@ CONTRACT mirror : public contract {
         );
     }
 
+    // Returns a depositor's recorded base deposit to them
+    [[eosio::action]]
+    void refund(const symbol_code& base_ticker, const name& depositor) {
+        ARENA_REPORT_SCOPE();
+        require_auth(depositor);
+        asset amount = settle_deposit(base_ticker, depositor);
+
+        totems::transfer(
+            get_self(),
+            depositor,
+            amount,
+            std::string("Refunded deposit")
+        );
+    }
+
+    // The creator claims a recorded deposit: it drops out of the ledger and is
+    // absorbed as backing by the next `mint`
+    [[eosio::action]]
+    void sweep(const symbol_code& base_ticker, const name& depositor) {
+        ARENA_REPORT_SCOPE();
+        totems::context ctx;
+        auto base_totem = ctx.get_totem(base_ticker);
+        check(base_totem != nullptr, "Base totem does not exist");
+        require_auth(base_totem->creator);
+        settle_deposit(base_ticker, depositor);
+    }
+
     [[eosio::on_notify(TOTEMS_MINT_NOTIFY)]]
     void on_mint(const name& mod, const name& minter, const asset& quantity, const asset& payment, const std::string& memo) {}
 
     [[eosio::on_notify(TOTEMS_TRANSFER_NOTIFY)]]
     void on_transfer(const name& from, const name& to, const asset& quantity, const std::string& memo) {
+        ARENA_REPORT_SCOPE();
         if (to != get_self() || from == get_self()) {
             return;
         }
@@ -101,7 +310,10 @@ CONTRACT mirror : public contract {
         pairings_table pairings(get_self(), get_self().value);
         auto pair_itr = pairings.find(synth_sym.code().raw());
         if (pair_itr == pairings.end()) {
-            return; // Not a synth token (e.g. base token deposit) — accept silently
+            // Not a synth token: base deposits from anyone but the creator are recorded,
+            // anything else is accepted silently
+            record_deposit(pairings, from, quantity);
+            return;
         }
 
         totems::check_license(quantity.symbol.code(), get_self());
@@ -111,6 +323,12 @@ CONTRACT mirror : public contract {
 
         pairings.modify(pair_itr, get_self(), [&](auto& row) {
             row.base_locked -= asset{quantity.amount, base_sym};
+#ifndef MIRROR_NO_STATS
+            auto& stats = current_stats(row);
+            stats.redemptions++;
+            stats.redeemed += quantity.amount;
+            stats.last_activity = current_time_point();
+#endif
         });
 
         // Send base tokens to the redeemer
@@ -129,4 +347,135 @@ CONTRACT mirror : public contract {
             std::make_tuple(get_self(), quantity, std::string("Burned redeemed synths"))
         ).send();
     }
+
+   private:
+    void record_deposit(pairings_table& pairings, const name& from, const asset& quantity) {
+        auto base_idx = pairings.get_index<"bybase"_n>();
+        if (base_idx.find(quantity.symbol.code().raw()) == base_idx.end()) {
+            return; // Not a base of any pairing
+        }
+
+        totems::context ctx;
+        auto base_totem = ctx.get_totem(quantity.symbol.code());
+        if (base_totem == nullptr || base_totem->creator == from) {
+            return; // Creator deposits are what `mint` turns into synths
+        }
+        if (below_min_deposit(quantity)) {
+            return; // Dust, not worth a row
+        }
+
+        deposits_table deposits(get_self(), quantity.symbol.code().raw());
+        auto it = deposits.find(from.value);
+        if (it == deposits.end()) {
+            deposits.emplace(get_self(), [&](auto& row) {
+                row.depositor = from;
+                row.amount = quantity;
+            });
+        } else {
+            deposits.modify(it, get_self(), [&](auto& row) {
+                row.amount += quantity;
+            });
+        }
+
+        unclaimed_table unclaimed(get_self(), get_self().value);
+        auto total = unclaimed.find(quantity.symbol.code().raw());
+        if (total == unclaimed.end()) {
+            unclaimed.emplace(get_self(), [&](auto& row) {
+                row.base_ticker = quantity.symbol.code();
+                row.total = quantity;
+            });
+        } else {
+            unclaimed.modify(total, get_self(), [&](auto& row) {
+                row.total += quantity;
+            });
+        }
+    }
+
+    // Removes a depositor's ledger entry and returns what it held
+    asset settle_deposit(const symbol_code& base_ticker, const name& depositor) {
+        deposits_table deposits(get_self(), base_ticker.raw());
+        auto it = deposits.find(depositor.value);
+        check(it != deposits.end(), "No deposit recorded for this account");
+        asset amount = it->amount;
+        deposits.erase(it);
+
+        unclaimed_table unclaimed(get_self(), get_self().value);
+        auto total = unclaimed.require_find(base_ticker.raw(), "Unclaimed total missing for base ticker");
+        if (total->total == amount) {
+            unclaimed.erase(total);
+        } else {
+            unclaimed.modify(total, get_self(), [&](auto& row) {
+                row.total -= amount;
+            });
+        }
+        return amount;
+    }
+
+    // Compares whole tokens, so MIRROR_MIN_DEPOSIT * 10^precision can't overflow
+    static bool below_min_deposit(const asset& quantity) {
+        int64_t unit = 1;
+        for (uint8_t i = 0; i < quantity.symbol.precision(); ++i) unit *= 10;
+        return quantity.amount / unit < MIRROR_MIN_DEPOSIT;
+    }
+
+    int64_t unclaimed_deposits(const symbol_code& base_ticker) {
+        unclaimed_table unclaimed(get_self(), get_self().value);
+        auto total = unclaimed.find(base_ticker.raw());
+        return total == unclaimed.end() ? 0 : total->total.amount;
+    }
+
+    // Adds to the running total of the same base, or starts one
+    static void add_locked(std::vector<asset>& totals, const asset& locked) {
+        auto total = std::find_if(totals.begin(), totals.end(),
+                                  [&](const asset& a) { return a.symbol == locked.symbol; });
+        if (total == totals.end()) {
+            totals.push_back(locked);
+        } else {
+            *total += locked;
+        }
+    }
+
+    // Lists a new pairing in its creator's view and bumps their aggregate
+    void index_pairing(const name& creator, const symbol_code& synth_ticker, const symbol_code& base_ticker) {
+        creator_pairings_table view(get_self(), creator.value);
+        view.emplace(get_self(), [&](auto& row) {
+            row.synth_ticker = synth_ticker;
+            row.base_ticker = base_ticker;
+        });
+
+        creators_table creators(get_self(), get_self().value);
+        auto it = creators.find(creator.value);
+        if (it == creators.end()) {
+            creators.emplace(get_self(), [&](auto& row) {
+                row.creator = creator;
+                row.pairings = 1;
+            });
+        } else {
+            creators.modify(it, same_payer, [&](auto& row) {
+                row.pairings++;
+            });
+        }
+    }
+
+    // Fills in what each version added, for a row last written at `from`
+    void upgrade_pairing(Pairing& row, uint8_t from) {
+        // v1: row_version itself, nothing else to fill in
+        if (from < 2) row.stats.emplace();
+        if (from < 3) {
+            totems::context ctx;
+            auto synth_totem = ctx.get_totem(row.synth_ticker);
+            check(synth_totem != nullptr, "Synth totem does not exist");
+            index_pairing(synth_totem->creator, row.synth_ticker, row.base_ticker);
+        }
+    }
+
+    // Rows not migrated yet are brought up to date on their first write
+    PairingStats& current_stats(Pairing& row) {
+        uint8_t from = migration::row_version(row);
+        if (from < PAIRING_VERSION) {
+            upgrade_pairing(row, from);
+            row.row_version.emplace(PAIRING_VERSION);
+        }
+        return row.stats.value();
+    }
 };
@@ -0,0 +1,162 @@
+#include <eosio/asset.hpp>
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+
+#include "../library/totems.hpp"
+using namespace eosio;
+
+/*
+ * Mirror shard registry (factory mode)
+ *
+ * Spreads pairings over N identical mirror deployments ("shards") so no single account's RAM
+ * and `pairings` table carries every creator. Shards are mirror.cpp built with
+ * -DMIRROR_REGISTRY=\"<this account>\", which makes their `setup` accept only this contract.
+ *
+ * A synth is routed deterministically: to the creator's isolated shard if they have one,
+ * otherwise to shared_shards[hash(synth) % shared_shards.size()]. The route is recorded on
+ * provisioning so adding shards later never moves an existing pairing.
+ */
+CONTRACT registry : public contract {
+   public:
+    using contract::contract;
+
+    struct [[eosio::table]] ShardPool {
+        // Append-only: the position of a shard is part of the routing function
+        std::vector<name> shared_shards;
+    };
+
+    typedef eosio::singleton<"shardpool"_n, ShardPool> shardpool_singleton;
+
+    // Creators with a dedicated shard
+    struct [[eosio::table]] Isolation {
+        name creator;
+        name shard;
+        uint64_t primary_key() const { return creator.value; }
+        uint64_t by_shard() const { return shard.value; }
+    };
+
+    typedef eosio::multi_index<"isolations"_n, Isolation,
+        indexed_by<"byshard"_n, const_mem_fun<Isolation, uint64_t, &Isolation::by_shard>>> isolations_table;
+
+    struct [[eosio::table]] Route {
+        symbol_code synth_ticker;
+        name shard;
+        name creator;
+        uint64_t primary_key() const { return synth_ticker.raw(); }
+    };
+
+    typedef eosio::multi_index<"routes"_n, Route> routes_table;
+
+    [[eosio::action]]
+    void addshard(const name& shard) {
+        require_auth(get_self());
+        check(is_account(shard), "Shard account does not exist");
+
+        isolations_table isolations(get_self(), get_self().value);
+        auto by_shard = isolations.get_index<"byshard"_n>();
+        check(by_shard.find(shard.value) == by_shard.end(), "Shard is already isolated to a creator");
+
+        shardpool_singleton pool_singleton(get_self(), get_self().value);
+        auto pool = pool_singleton.get_or_default();
+        check(std::find(pool.shared_shards.begin(), pool.shared_shards.end(), shard) == pool.shared_shards.end(),
+              "Shard is already in the shared pool");
+        pool.shared_shards.push_back(shard);
+        pool_singleton.set(pool, get_self());
+    }
+
+    // Gives a creator a dedicated shard; only affects synths provisioned afterwards
+    [[eosio::action]]
+    void isolate(const name& creator, const name& shard) {
+        require_auth(get_self());
+        check(is_account(shard), "Shard account does not exist");
+
+        shardpool_singleton pool_singleton(get_self(), get_self().value);
+        auto pool = pool_singleton.get_or_default();
+        check(std::find(pool.shared_shards.begin(), pool.shared_shards.end(), shard) == pool.shared_shards.end(),
+              "Shard is in the shared pool");
+
+        isolations_table isolations(get_self(), get_self().value);
+        auto by_shard = isolations.get_index<"byshard"_n>();
+        auto owner = by_shard.find(shard.value);
+        check(owner == by_shard.end() || owner->creator == creator, "Shard is already isolated to another creator");
+
+        auto it = isolations.find(creator.value);
+        if (it == isolations.end()) {
+            isolations.emplace(get_self(), [&](auto& row) {
+                row.creator = creator;
+                row.shard = shard;
+            });
+        } else {
+            isolations.modify(it, get_self(), [&](auto& row) {
+                row.shard = shard;
+            });
+        }
+    }
+
+    // Where a synth lives (or would be provisioned) so clients know where to send
+    // mints and redemptions. `creator` is only used for synths that aren't routed yet.
+    [[eosio::action, eosio::read_only]]
+    name route(const symbol_code& synth_ticker, const name& creator) {
+        routes_table routes(get_self(), get_self().value);
+        auto it = routes.find(synth_ticker.raw());
+        if (it != routes.end()) {
+            return it->shard;
+        }
+        return pick_shard(synth_ticker, creator);
+    }
+
+    // Routes the synth and creates its pairing on the chosen shard
+    [[eosio::action]]
+    void provision(const symbol& synth_ticker, const symbol& base_ticker) {
+        totems::context ctx;
+        auto synth_totem = ctx.get_totem(synth_ticker.code());
+        check(synth_totem != nullptr, "Synth totem does not exist");
+        require_auth(synth_totem->creator);
+
+        routes_table routes(get_self(), get_self().value);
+        check(routes.find(synth_ticker.code().raw()) == routes.end(), "Synth ticker is already routed");
+
+        // The totem was created against whatever `route` returned at the time; if the pool or the
+        // creator's isolation changed since, the pick differs and the route would be permanent
+        // on a shard that can never mint or redeem this synth
+        name shard = pick_shard(synth_ticker.code(), synth_totem->creator);
+        check(has_mod(synth_totem->mods.mint, shard) && has_mod(synth_totem->mods.transfer, shard),
+              "Synth totem must use its routed shard " + shard.to_string() + " as mint and transfer mod");
+
+        routes.emplace(synth_totem->creator, [&](auto& row) {
+            row.synth_ticker = synth_ticker.code();
+            row.shard = shard;
+            row.creator = synth_totem->creator;
+        });
+
+        // The shard re-checks both totems, creator match and precision
+        action(
+            permission_level{get_self(), "active"_n},
+            shard,
+            "setup"_n,
+            std::make_tuple(synth_ticker, base_ticker)
+        ).send();
+    }
+
+   private:
+    static bool has_mod(const std::vector<name>& mods, const name& shard) {
+        return std::find(mods.begin(), mods.end(), shard) != mods.end();
+    }
+
+    name pick_shard(const symbol_code& synth_ticker, const name& creator) {
+        isolations_table isolations(get_self(), get_self().value);
+        auto isolation = isolations.find(creator.value);
+        if (isolation != isolations.end()) {
+            return isolation->shard;
+        }
+
+        shardpool_singleton pool_singleton(get_self(), get_self().value);
+        auto pool = pool_singleton.get_or_default();
+        check(!pool.shared_shards.empty(), "No shards registered");
+
+        // Fibonacci hashing spreads sequential tickers evenly; fixed so routes are reproducible off-chain
+        uint64_t hash = synth_ticker.raw() * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+        return pool.shared_shards[hash % pool.shared_shards.size()];
+    }
+};
@@ -0,0 +1,86 @@
+#!/usr/bin/env bash
+# Size-minimized release build of mirror.wasm
+#
+# Compiles for size, runs binaryen's wasm-opt over the linked module and
+# compares the result against the currently committed build/mirror.wasm.
+# The optimized artifacts land in build/release/ so the committed build is
+# only replaced when you choose to copy them over.
+#
+# Usage:
+#   scripts/build-release.sh [--network jungle|local_test] [--install]
+#
+#   --network  totems.hpp network profile to compile against (default: jungle).
+#              Artifacts go to build/release/<network>/.
+#   --install  also copy the release artifacts to build/, with build/mirror.sources.sha256
+#              recording the sources they were built from (see scripts/check-artifacts.sh)
+#
+# Requires: cdt-cpp (CDT v4.1.x) and binaryen (wasm-opt) on PATH.
+set -euo pipefail
+
+NETWORK=jungle
+INSTALL=0
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --network) NETWORK="$2"; shift 2 ;;
+        --install) INSTALL=1; shift ;;
+        *) echo "unknown option: $1" >&2; exit 2 ;;
+    esac
+done
+case "$NETWORK" in
+    jungle|local_test) ;;
+    *) echo "unknown network: $NETWORK (jungle, local_test)" >&2; exit 2 ;;
+esac
+if [[ "$INSTALL" == 1 && "$NETWORK" == local_test ]]; then
+    echo "local_test builds have no proxy licence lookup and are never installed to build/" >&2
+    exit 2
+fi
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+OUT_DIR="$ROOT/build/release/$NETWORK"
+BASELINE="$ROOT/build/mirror.wasm"
+mkdir -p "$OUT_DIR"
+
+# Optimize for size; wasm-ld already garbage collects any
+# totems.hpp helper the contract doesn't reference, so only what mirror.cpp
+# calls ends up in the module.
+mkdir -p "$OUT_DIR/unopt"
+cdt-cpp -abigen -Os -DTOTEMS_NETWORK_"${NETWORK^^}" \
+    -I "$ROOT/contracts/library" \
+    -o "$OUT_DIR/unopt/mirror.wasm" "$ROOT/contracts/mirror/mirror.cpp"
+cp "$OUT_DIR/unopt/mirror.abi" "$OUT_DIR/mirror.abi"
+
+# Antelope only accepts MVP wasm, so keep binaryen from introducing newer
+# opcodes (sign-ext, bulk-memory, ...) while it shrinks the module.
+wasm-opt -Oz --mvp-features --strip-debug --strip-producers \
+    "$OUT_DIR/unopt/mirror.wasm" -o "$OUT_DIR/mirror.wasm"
+
+size_of() { wc -c < "$1" | tr -d ' '; }
+
+# setcode bills 10 bytes of RAM per byte of code (setcode_ram_bytes_multiplier)
+report() {
+    local label="$1" bytes="$2"
+    printf "  %-22s %8d bytes  (%d bytes RAM on setcode)\n" "$label" "$bytes" $((bytes * 10))
+}
+
+UNOPT=$(size_of "$OUT_DIR/unopt/mirror.wasm")
+RELEASE=$(size_of "$OUT_DIR/mirror.wasm")
+
+echo "== mirror.wasm size comparison ($NETWORK)"
+if [[ -f "$BASELINE" ]]; then
+    CURRENT=$(size_of "$BASELINE")
+    report "build/mirror.wasm" "$CURRENT"
+fi
+report "release (pre wasm-opt)" "$UNOPT"
+report "release" "$RELEASE"
+if [[ -n "${CURRENT:-}" ]]; then
+    DELTA=$((RELEASE - CURRENT))
+    printf "  %-22s %+8d bytes  (%+d bytes RAM on setcode)\n" "delta" "$DELTA" $((DELTA * 10))
+fi
+
+if [[ "$INSTALL" == 1 ]]; then
+    cp "$OUT_DIR/mirror.wasm" "$OUT_DIR/mirror.abi" "$ROOT/build/"
+    (cd "$ROOT" && sha256sum contracts/mirror/*.cpp contracts/mirror/*.hpp contracts/library/*.hpp) \
+        > "$ROOT/build/mirror.sources.sha256"
+    echo "Copied release artifacts to build/"
+    "$ROOT/scripts/check-artifacts.sh"
+fi
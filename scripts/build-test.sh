@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+# Builds every contract artifact the specs and benchmarks load from build/test/
+#
+#   build/test/mirror           tests/mirror.spec.ts, tests/migration.spec.ts, tests/mirror.bench.ts
+#   build/test/registry         tests/registry.spec.ts
+#   build/test/mirror_sharded   tests/registry.spec.ts (mirror.cpp as a shard of `registry`)
+#   build/test/modprobe         tests/modview.spec.ts
+#   build/test/proxyprobe       tests/license.spec.ts (deployed at the proxy mod account)
+#
+# build/mirror_v0 (tests/migration.spec.ts) is the first release's artifact and is
+# committed, never rebuilt.
+#
+# All of them are compiled against the local VM network profile, which has no proxy
+# licence lookup, so they must never be deployed: they stay out of build/ (the deploy
+# artifacts) and out of git. Run it after any contract change, before the tests:
+#
+#   scripts/build-test.sh && npx tsx --test tests/*.spec.ts
+#
+# Requires: cdt-cpp (CDT v4.1.x) on PATH.
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+OUT_DIR="$ROOT/build/test"
+mkdir -p "$OUT_DIR"
+
+build() {
+    local out="$1" src="$2"
+    shift 2
+    echo "== build/test/$out.wasm"
+    cdt-cpp -abigen -DTOTEMS_NETWORK_LOCAL_TEST -I "$ROOT/contracts/library" "$@" \
+        -o "$OUT_DIR/$out.wasm" "$ROOT/$src"
+}
+
+build mirror contracts/mirror/mirror.cpp
+build registry contracts/registry/registry.cpp
+# The registry account in tests/registry.spec.ts is `registry`
+build mirror_sharded contracts/mirror/mirror.cpp -DMIRROR_REGISTRY=\"registry\"
+build modprobe tests/contracts/modprobe.cpp
+build proxyprobe tests/contracts/proxyprobe.cpp
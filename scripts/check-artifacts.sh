@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+# Checks that build/mirror.wasm and build/mirror.abi were built from the current sources
+#
+# build/ holds the deploy artifacts, so a contract change that was never compiled
+# would otherwise ship the previous contract. Two checks, both must pass:
+#   - the actions and tables declared in contracts/mirror are exactly the ones in
+#     build/mirror.abi (catches an ABI that predates new actions or tables)
+#   - build/mirror.sources.sha256, written by `scripts/build-release.sh --install` next
+#     to the artifacts it installs, still matches every source file they were compiled
+#     from (catches changes that leave the ABI as it was)
+#
+# Run it before deploying (see README "Deploy"). It exits non-zero with what is stale;
+# the fix is always `scripts/build-release.sh --install` and committing build/.
+#
+# Usage: scripts/check-artifacts.sh
+# Requires: jq, sha256sum
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+cd "$ROOT"
+ABI=build/mirror.abi
+STAMP=build/mirror.sources.sha256
+STALE=0
+
+# `[[eosio::action("name")...]]` names the action, a bare `[[eosio::action...]]` takes the
+# name of the function declared on the next line
+source_actions() {
+    awk '
+        pending { if (match($0, /[A-Za-z_0-9]+\(/)) { print substr($0, RSTART, RLENGTH - 1); pending = 0 } next }
+        /\[\[eosio::action\("/ { sub(/.*\[\[eosio::action\("/, ""); sub(/".*/, ""); print; next }
+        /\[\[eosio::action[],]/ { pending = 1 }
+    ' contracts/mirror/*.cpp contracts/mirror/*.hpp | sort
+}
+
+source_tables() {
+    grep -ho 'multi_index<"[a-z1-5.]*"_n' contracts/mirror/*.cpp contracts/mirror/*.hpp |
+        sed 's/multi_index<"\(.*\)"_n/\1/' | sort
+}
+
+compare() {
+    local kind="$1" expected="$2" actual="$3" missing extra
+    missing=$(comm -23 <(echo "$expected") <(echo "$actual") | tr '\n' ' ')
+    extra=$(comm -13 <(echo "$expected") <(echo "$actual") | tr '\n' ' ')
+    if [[ -n "$missing" ]]; then echo "$ABI lacks $kind: $missing"; STALE=1; fi
+    if [[ -n "$extra" ]]; then echo "$ABI has $kind no longer in the source: $extra"; STALE=1; fi
+}
+
+compare actions "$(source_actions)" "$(jq -r '.actions[].name' "$ABI" | sort)"
+compare tables "$(source_tables)" "$(jq -r '.tables[].name' "$ABI" | sort)"
+
+if [[ ! -f "$STAMP" ]]; then
+    echo "$STAMP is missing: build/mirror.* were not installed by scripts/build-release.sh"
+    STALE=1
+elif ! sha256sum --check --quiet "$STAMP" 2>/dev/null; then
+    echo "Sources changed since build/mirror.* were built (see $STAMP)"
+    STALE=1
+fi
+
+if [[ "$STALE" == 1 ]]; then
+    echo "build/mirror.wasm and build/mirror.abi are stale: run scripts/build-release.sh --install"
+    exit 1
+fi
+echo "build/mirror.wasm and build/mirror.abi match the sources"
@@ -0,0 +1,97 @@
+#!/usr/bin/env bash
+# Per-function size and static instruction profile for mirror.wasm
+#
+# Builds the contract through the same pipeline as scripts/build-release.sh
+# (cdt-cpp -Os with the network define, then wasm-opt -Oz) but keeps the wasm
+# name section, so every function shows up with its demangled C++ name instead
+# of func[N], and then breaks the binary down per function using wabt's
+# `wasm-objdump`.
+#
+# Usage:
+#   scripts/profile.sh [--network jungle|local_test]   # profile a fresh release-pipeline build
+#   scripts/profile.sh build/mirror.wasm                        # profile an existing artifact (names only if present)
+#
+# Requires: cdt-cpp (CDT v4.1.x), binaryen (wasm-opt) and wabt (wasm-objdump) on PATH.
+set -euo pipefail
+
+NETWORK=jungle
+WASM=""
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --network) NETWORK="$2"; shift 2 ;;
+        -*) echo "unknown option: $1" >&2; exit 2 ;;
+        *) WASM="$1"; shift ;;
+    esac
+done
+case "$NETWORK" in
+    jungle|local_test) ;;
+    *) echo "unknown network: $NETWORK (jungle, local_test)" >&2; exit 2 ;;
+esac
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+OUT_DIR="$ROOT/build/profile"
+mkdir -p "$OUT_DIR"
+
+if [[ -z "$WASM" ]]; then
+    WASM="$OUT_DIR/mirror.wasm"
+    # Same flags as the release build; -g only adds debug info and the name section.
+    # wasm-opt -g keeps the names through optimization and --strip-dwarf drops the DWARF
+    # sections (--strip-debug would drop the names too), so the code section matches
+    # build/release/<network>/mirror.wasm.
+    cdt-cpp -abigen -Os -g -DTOTEMS_NETWORK_"${NETWORK^^}" \
+        -I "$ROOT/contracts/library" \
+        -o "$OUT_DIR/unopt.wasm" "$ROOT/contracts/mirror/mirror.cpp"
+    wasm-opt -Oz -g --mvp-features --strip-dwarf --strip-producers \
+        "$OUT_DIR/unopt.wasm" -o "$WASM"
+fi
+
+DUMP_HEADERS="$OUT_DIR/headers.txt"
+DUMP_DISASM="$OUT_DIR/disasm.txt"
+wasm-objdump -h "$WASM" > "$DUMP_HEADERS"
+wasm-objdump -x "$WASM" > "$OUT_DIR/details.txt"
+wasm-objdump -d "$WASM" > "$DUMP_DISASM"
+
+echo "== $WASM: $(wc -c < "$WASM") bytes"
+echo
+echo "== Sections"
+# Header lines look like: `     Code start=0x0000012a end=0x00001f00 (size=0x00001dd6) count: 42`
+grep 'start=0x' "$DUMP_HEADERS" | while read -r section _ _ size _; do
+    size="${size#"(size="}"
+    size="${size%")"}"
+    printf "  %-10s %8d bytes\n" "$section" "$((size))"
+done
+echo
+echo "== Host intrinsics imported"
+awk '/^Import\[/ { on = 1; next } /^[A-Z][a-z]+\[/ { on = 0 } on && /<- env\./ { sub(/.*<- env\./, ""); print "  " $0 }' \
+    "$OUT_DIR/details.txt"
+echo
+echo "== Functions (body bytes, static instructions), largest first"
+# Code section entries look like: ` - func[12] size=345 <mirror::mint(...)>`
+# Disassembly lines look like:    ` 0001a2: 20 00  | local.get 0`
+awk '
+    FNR == NR {
+        if ($0 ~ /^ - func\[[0-9]+\] size=/) {
+            idx = $2; sub(/func\[/, "", idx); sub(/\]/, "", idx)
+            sz = $3; sub(/size=/, "", sz)
+            name = $0; sub(/^[^<]*</, "", name); sub(/>$/, "", name)
+            if (name == $0) name = "func[" idx "]"
+            size[idx] = sz; label[idx] = name
+        }
+        next
+    }
+    /^[0-9a-f]+ func\[[0-9]+\]/ {
+        cur = $2; sub(/func\[/, "", cur); sub(/\].*/, "", cur)
+        next
+    }
+    /^ [0-9a-f]+:.*\| / {
+        op = $0; sub(/^[^|]*\| */, "", op)
+        if (op != "" && op !~ /^local\[/) insns[cur]++
+    }
+    END {
+        for (i in size) printf "%8d %8d  %s\n", size[i], insns[i], label[i]
+    }
+' "$OUT_DIR/details.txt" "$DUMP_DISASM" | sort -rn | awk '
+    BEGIN { printf "  %8s %8s  %s\n", "bytes", "insns", "function" }
+    { total += $1; printf "  %s\n", $0 }
+    END { printf "  %8d total code bytes\n", total }
+'
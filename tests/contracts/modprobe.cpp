@@ -0,0 +1,37 @@
+#include <eosio/eosio.hpp>
+
+#include "../../contracts/library/totems.hpp"
+using namespace eosio;
+
+/*
+ * Test-only contract: checks totems::mod_view (which walks the packed `mods` row)
+ * against a full decode of the same row through get_mod. Never deployed.
+ */
+CONTRACT modprobe : public contract {
+   public:
+    using contract::contract;
+
+    // Fails with a description of the first difference between the two decoders
+    [[eosio::action]]
+    void compare(const name& mod, const name& hook) {
+        auto full = totems::get_mod(mod);
+        check(full.has_value(), "Mod is not published in market");
+        auto view = totems::mod_view::find(mod);
+        check(view.has_value(), "mod_view did not find the mod");
+
+        check(view->has_hook(hook) == full->has_hook(hook), "has_hook differs for " + hook.to_string());
+        if (!full->has_hook(hook)) {
+            return;
+        }
+
+        std::vector<totems::RequiredAction> expected;
+        for (const auto& entry : full->required_actions) {
+            if (entry.hook == hook) {
+                expected.insert(expected.end(), entry.actions.begin(), entry.actions.end());
+            }
+        }
+        auto actual = totems::get_required_actions(hook, {mod});
+        check(actual.size() == expected.size(), "Required action count differs for " + hook.to_string());
+        check(pack(actual) == pack(expected), "Required actions differ for " + hook.to_string());
+    }
+};
@@ -0,0 +1,33 @@
+#include <eosio/eosio.hpp>
+
+#include "../../contracts/library/totems.hpp"
+using namespace eosio;
+
+/*
+ * Test-only contract, deployed at the proxy mod account (`totemodproxy`): grants licences the
+ * way the proxy mod contract does, in its own `licenses` table scoped by ticker, and runs
+ * totems::check_license under a network profile with and without the proxy lookup, so the
+ * proxy branch is exercised in the local VM. Never deployed.
+ */
+CONTRACT proxyprobe : public contract {
+   public:
+    using contract::contract;
+
+    [[eosio::action]]
+    void grant(const symbol_code& ticker, const name& mod) {
+        totems::license_table licenses(get_self(), ticker.raw());
+        licenses.emplace(get_self(), [&](auto& row) { row.mod = mod; });
+    }
+
+    // Jungle checks the totems licences, then this contract's
+    [[eosio::action]]
+    void checkjungle(const symbol_code& ticker, const name& mod) {
+        totems::check_license<totems::networks::jungle>(ticker, mod);
+    }
+
+    // The local VM profile only checks the totems licences
+    [[eosio::action]]
+    void checklocal(const symbol_code& ticker, const name& mod) {
+        totems::check_license<totems::networks::local_test>(ticker, mod);
+    }
+};
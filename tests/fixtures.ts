@@ -0,0 +1,60 @@
+import {
+    blockchain,
+    createAccount,
+    createTotem,
+    MOCK_MOD_DETAILS,
+    MOD_HOOKS,
+    publishMod,
+    setup,
+    totemMods
+} from "./helpers";
+
+// Pre-baked chain state shared by tests and benchmarks.
+//
+// Building the baseline (deploying totems + market, creating accounts, publishing the
+// mirror mod, creating the BASE/SYNTH totems and the pairing) is done once per process.
+// After that every `useBaseline()` rolls the table store back to that snapshot, which
+// only drops the rows written since, so each case starts from identical state and no
+// longer depends on what ran before it.
+//
+// node:test runs every file in its own process, so files that use this fixture
+// (rather than building on each other's state) can run with `--test-concurrency`.
+
+// MIRROR_BUILD points at another artifact (e.g. a -DMIRROR_NO_STATS build) to compare builds
+export const mirror = blockchain.createContract('mirror', process.env.MIRROR_BUILD ?? 'build/test/mirror', true);
+
+let snapshot: number | undefined;
+
+const buildBaseline = async () => {
+    await setup();
+    await createAccount('seller');
+    await createAccount('creator');
+    await createAccount('user');
+
+    await publishMod('seller', 'mirror', [MOD_HOOKS.Transfer, MOD_HOOKS.Mint], 0, MOCK_MOD_DETAILS(true));
+    await createTotem(
+        '4,BASE',
+        [{ recipient: 'creator', quantity: 1_000_000_000, label: 'Creator allocation', is_minter: false }],
+        totemMods({}),
+    );
+    await createTotem(
+        '4,SYNTH',
+        [{ recipient: 'mirror', quantity: 1_000_000_000, label: 'Synth supply', is_minter: true }],
+        totemMods({ transfer: ['mirror'], mint: ['mirror'] }),
+    );
+    await mirror.actions.setup(['4,SYNTH', '4,BASE']).send('creator');
+};
+
+/***
+ * Puts the chain into the baseline state: BASE and SYNTH totems created,
+ * `creator` holding all BASE, the mirror mod published and SYNTH paired to BASE.
+ */
+export const useBaseline = async () => {
+    if (snapshot === undefined) {
+        await buildBaseline();
+    } else {
+        blockchain.store.revertTo(snapshot);
+    }
+    // Reverting consumes the snapshot, so take a fresh one of the same state
+    snapshot = blockchain.store.snapshot();
+};
@@ -0,0 +1,44 @@
+import { beforeEach, describe, it } from "node:test";
+import {expectToThrow} from "@vaulta/vert";
+import { blockchain } from "./helpers";
+import { useBaseline } from "./fixtures";
+
+// tests/contracts/proxyprobe.cpp at the proxy mod account: licences granted there count only
+// under profiles with has_proxy_mods (jungle), while the local VM profile never looks at them
+const proxy = blockchain.createContract('totemodproxy', 'build/test/proxyprobe', true);
+
+describe('Licences', () => {
+    beforeEach(async () => {
+        await useBaseline();
+    });
+
+    it('should accept a mod licensed on the totems contract under every profile', async () => {
+        // The baseline SYNTH totem was created with the mirror mod
+        await proxy.actions.checkjungle(['SYNTH', 'mirror']).send('totemodproxy');
+        await proxy.actions.checklocal(['SYNTH', 'mirror']).send('totemodproxy');
+    });
+
+    it('should accept a proxy licence only where the network has the proxy contract', async () => {
+        await proxy.actions.grant(['SYNTH', 'proxiedmod']).send('totemodproxy');
+
+        await proxy.actions.checkjungle(['SYNTH', 'proxiedmod']).send('totemodproxy');
+        await expectToThrow(
+            proxy.actions.checklocal(['SYNTH', 'proxiedmod']).send('totemodproxy'),
+            "eosio_assert: Mod is not licensed for this totem: proxiedmod"
+        );
+    });
+
+    it('should reject a mod licensed nowhere', async () => {
+        // A proxy licence for another totem doesn't count either
+        await proxy.actions.grant(['BASE', 'proxiedmod']).send('totemodproxy');
+
+        await expectToThrow(
+            proxy.actions.checkjungle(['SYNTH', 'proxiedmod']).send('totemodproxy'),
+            "eosio_assert: Mod is not licensed for this totem: proxiedmod"
+        );
+        await expectToThrow(
+            proxy.actions.checkjungle(['SYNTH', 'unlicensed']).send('totemodproxy'),
+            "eosio_assert: Mod is not licensed for this totem: unlicensed"
+        );
+    });
+});
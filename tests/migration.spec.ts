@@ -0,0 +1,136 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+import {expectToThrow, nameToBigInt} from "@vaulta/vert";
+import {
+    blockchain,
+    createAccount,
+    createTotem,
+    getTotemBalance,
+    MOCK_MOD_DETAILS,
+    MOD_HOOKS,
+    publishMod,
+    setup,
+    totemMods, totems
+} from "./helpers";
+
+// Pairings written by the original contract (build/mirror_v0, the first release's artifact:
+// no row_version, no stats), then the current build deployed over them on the same account.
+// Creating a contract again for an existing account replaces its code and keeps its tables.
+const legacy = blockchain.createContract('mirror', 'build/mirror_v0', true);
+let mirror: ReturnType<typeof blockchain.createContract>;
+
+const pairing = (synth: string) =>
+    mirror.tables.pairings(nameToBigInt('mirror')).getTableRows().find(p => p.synth_ticker === synth)!;
+
+const createSynth = (ticker: string) => createTotem(
+    ticker,
+    [{ recipient: 'mirror', quantity: 1_000_000_000, label: 'Synth supply', is_minter: true }],
+    totemMods({ transfer: ['mirror'], mint: ['mirror'] }),
+);
+
+// Synths listed in the creator's view, and the creator's aggregate count
+const listed = () =>
+    mirror.tables.creatorpairs(nameToBigInt('creator')).getTableRows().map(row => row.synth_ticker).sort().join();
+const listedCount = () =>
+    mirror.tables.creators(nameToBigInt('mirror')).getTableRows().find(row => row.creator === 'creator')?.pairings ?? 0;
+
+const mint = (synth: string) =>
+    totems.actions.mint(['mirror', 'creator', `0.0000 ${synth}`, '0.0000 A', '']).send('creator');
+
+describe('Migration of pre-versioning pairings', () => {
+    it('should write pairings with the original contract', async () => {
+        await setup();
+        await createAccount('seller');
+        await createAccount('creator');
+        await publishMod('seller', 'mirror', [MOD_HOOKS.Transfer, MOD_HOOKS.Mint], 0, MOCK_MOD_DETAILS(true));
+        await createTotem(
+            '4,BASE',
+            [{ recipient: 'creator', quantity: 1_000_000_000, label: 'Creator allocation', is_minter: false }],
+            totemMods({}),
+        );
+
+        for (const synth of ['SYNTH', 'SYNTH2', 'SYNTH3']) {
+            await createSynth(`4,${synth}`);
+            await legacy.actions.setup([`4,${synth}`, '4,BASE']).send('creator');
+        }
+
+        await totems.actions.transfer(['creator', 'mirror', '100.0000 BASE', '']).send('creator');
+        await mint('SYNTH');
+        await totems.actions.transfer(['creator', 'mirror', '40.0000 BASE', '']).send('creator');
+        await mint('SYNTH2');
+
+        mirror = blockchain.createContract('mirror', 'build/test/mirror', true);
+        for (const synth of ['SYNTH', 'SYNTH2', 'SYNTH3']) {
+            const row = pairing(synth);
+            assert(row.row_version === undefined || row.row_version === null, `${synth} should be a v0 row`);
+        }
+        assert(pairing('SYNTH').base_locked === '100.0000 BASE', 'v0 reserves should be readable');
+        assert(listed() === '' && listedCount() === 0, 'v0 rows predate the creator view');
+    });
+
+    it('should redeem from a v0 row', async () => {
+        const before = getTotemBalance('creator', 'BASE');
+        await totems.actions.transfer(['creator', 'mirror', '10.0000 SYNTH2', '']).send('creator');
+        assert(getTotemBalance('creator', 'BASE') - before === 10, 'Redemption should return 10 BASE');
+
+        const row = pairing('SYNTH2');
+        assert(row.base_locked === '30.0000 BASE', `Expected 30.0000 BASE locked, got ${row.base_locked}`);
+        // Upgraded in place by the write
+        assert(row.row_version === 3, `Expected v3 after the write, got ${row.row_version}`);
+        assert(Number(row.stats.redemptions) === 1, `Expected 1 redemption, got ${row.stats.redemptions}`);
+        assert(Number(row.stats.redeemed) === 100_000, `Expected 10 redeemed, got ${row.stats.redeemed}`);
+        // v3 backfill on the redemption path
+        assert(listed() === 'SYNTH2', `Expected SYNTH2 listed, got ${listed()}`);
+        assert(listedCount() === 1, `Expected 1 pairing counted, got ${listedCount()}`);
+    });
+
+    it('should mint on a v0 row', async () => {
+        const before = getTotemBalance('creator', 'SYNTH');
+        await totems.actions.transfer(['creator', 'mirror', '50.0000 BASE', '']).send('creator');
+        await mint('SYNTH');
+        assert(getTotemBalance('creator', 'SYNTH') - before === 50, 'Mint should only count the new deposit');
+
+        const row = pairing('SYNTH');
+        assert(row.base_locked === '150.0000 BASE', `Expected 150.0000 BASE locked, got ${row.base_locked}`);
+        assert(row.row_version === 3, `Expected v3 after the write, got ${row.row_version}`);
+        assert(Number(row.stats.mints) === 1, `Expected 1 mint since the upgrade, got ${row.stats.mints}`);
+        assert(Number(row.stats.minted) === 500_000, `Expected 50 minted, got ${row.stats.minted}`);
+        // v3 backfill on the mint path
+        assert(listed() === 'SYNTH,SYNTH2', `Expected SYNTH and SYNTH2 listed, got ${listed()}`);
+        assert(listedCount() === 2, `Expected 2 pairings counted, got ${listedCount()}`);
+    });
+
+    it('should migrate the remaining v0 rows', async () => {
+        // Three rows, one per call; the two already written are skipped but still count
+        for (let i = 0; i < 3; i++) {
+            await mirror.actions.migrate([1]).send('creator');
+        }
+        const state = mirror.tables.migrations(nameToBigInt('mirror')).getTableRows()[0];
+        assert(state.version === 3, `Migration should be complete, got version ${state.version}`);
+        await expectToThrow(
+            mirror.actions.migrate([1]).send('creator'),
+            "eosio_assert: Migration already complete"
+        );
+
+        const row = pairing('SYNTH3');
+        assert(row.row_version === 3, `Expected SYNTH3 at v3, got ${row.row_version}`);
+        assert(Number(row.stats.mints) === 0 && Number(row.stats.redemptions) === 0, 'Backfilled stats start at zero');
+        assert(row.base_locked === '0.0000 BASE', `Migration changed SYNTH3 reserves to ${row.base_locked}`);
+        assert(pairing('SYNTH2').base_locked === '30.0000 BASE', 'Migration changed SYNTH2 reserves');
+        assert(pairing('SYNTH').base_locked === '150.0000 BASE', 'Migration changed SYNTH reserves');
+
+        // Only SYNTH3 was still unlisted; the rows written since are not indexed twice
+        assert(listed() === 'SYNTH,SYNTH2,SYNTH3', `Expected all three listed, got ${listed()}`);
+        assert(listedCount() === 3, `Expected 3 pairings counted, got ${listedCount()}`);
+    });
+
+    it('should summarize the backfilled creator', async () => {
+        await mirror.actions.creatorinfo(['creator']).send('creator');
+        const summary = blockchain.actionTraces.at(-1)!.decodedReturnValue;
+        assert(summary.pairing_count === 3, `Expected 3 pairings, got ${summary.pairing_count}`);
+        assert(summary.pairings.length === 3, `Expected 3 pairing rows, got ${summary.pairings.length}`);
+        // 150 (SYNTH) + 30 (SYNTH2) + 0 (SYNTH3), all backed by BASE
+        assert(summary.locked_per_base.join() === '180.0000 BASE',
+            `Expected 180.0000 BASE locked, got ${summary.locked_per_base.join()}`);
+    });
+});
@@ -0,0 +1,140 @@
+import { describe, it } from "node:test";
+import { performance } from "node:perf_hooks";
+import {
+    blockchain,
+    createTotem,
+    totemMods, totems
+} from "./helpers";
+import { mirror, useBaseline } from "./fixtures";
+
+// Per-action execution profile for the mirror contract.
+// Run with the same runner as the specs and redirect to bench_output.txt:
+//   npx tsx --test tests/mirror.bench.ts > bench_output.txt
+// Every result line is `bench <case> runs=<n> mean_us=<x> p50_us=<y> p99_us=<z>`
+// so it can be diffed between builds and fed to other tooling.
+//
+// Pairing activity counters: mint and redeem update them inside the pairing write they
+// already do, so the difference between these two runs is their whole CPU cost:
+//   npx tsx --test tests/mirror.bench.ts > bench_output.txt
+//   MIRROR_BUILD=build/mirror_nostats npx tsx --test tests/mirror.bench.ts > bench_nostats.txt
+// Their RAM cost is fixed: 36 bytes (PairingStats) per pairing row and no extra rows,
+// whether or not the build updates them.
+//
+// Heap use: point MIRROR_BUILD at a -DMIRROR_ARENA -DMIRROR_ARENA_REPORT build and every
+// line also gets the action's peak arena bytes and the bytes that overflowed to the regular heap.
+
+const RUNS = Number(process.env.BENCH_RUNS ?? 200);
+
+type HeapUse = { peak: number, overflow: number };
+
+// Contracts built with -DMIRROR_ARENA -DMIRROR_ARENA_REPORT print their heap use per action
+const arenaUse = (): HeapUse | undefined => {
+    const reports = [...blockchain.console.matchAll(/arena_peak_bytes=(\d+) arena_overflow_bytes=(\d+)/g)];
+    if (!reports.length) return undefined;
+    return {
+        peak: Math.max(...reports.map(m => Number(m[1]))),
+        overflow: Math.max(...reports.map(m => Number(m[2]))),
+    };
+};
+
+const report = (label: string, samples: number[], heapUse?: HeapUse) => {
+    const sorted = [...samples].sort((a, b) => a - b);
+    const mean = sorted.reduce((a, b) => a + b, 0) / sorted.length;
+    const pct = (p: number) => sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+    const heap = heapUse === undefined ? '' : ` arena_peak_bytes=${heapUse.peak} arena_overflow_bytes=${heapUse.overflow}`;
+    console.log(`bench ${label} runs=${sorted.length} mean_us=${mean.toFixed(1)} p50_us=${pct(0.5).toFixed(1)} p99_us=${pct(0.99).toFixed(1)}${heap}`);
+};
+
+// `prepare` runs before each sample and is not timed
+const measure = async (label: string, runs: number, fn: () => Promise<unknown>, prepare?: () => Promise<unknown>) => {
+    const samples: number[] = [];
+    let heapUse: HeapUse | undefined;
+    for (let i = 0; i < runs; i++) {
+        if (prepare) await prepare();
+        const start = performance.now();
+        await fn();
+        samples.push((performance.now() - start) * 1000);
+        const use = arenaUse();
+        if (use !== undefined) {
+            heapUse = {
+                peak: Math.max(heapUse?.peak ?? 0, use.peak),
+                overflow: Math.max(heapUse?.overflow ?? 0, use.overflow),
+            };
+        }
+    }
+    report(label, samples, heapUse);
+};
+
+// Synth tickers for freshly paired synths; symbol codes are letters only
+let created = 0;
+const nextSynth = () => {
+    let n = created++, suffix = '';
+    for (let i = 0; i < 5; i++, n = Math.floor(n / 26)) suffix = String.fromCharCode(65 + n % 26) + suffix;
+    return `SY${suffix}`;
+};
+
+const createSynth = (synth: string) => createTotem(
+    `4,${synth}`,
+    [{ recipient: 'mirror', quantity: 1_000_000_000, label: 'Synth supply', is_minter: true }],
+    totemMods({ transfer: ['mirror'], mint: ['mirror'] }),
+);
+
+describe('Mirror benchmarks', () => {
+    it('should profile setup', async () => {
+        await useBaseline();
+        // Every sample pairs a fresh synth, created untimed
+        let synth = '';
+        await measure(
+            'setup',
+            RUNS,
+            () => mirror.actions.setup([`4,${synth}`, '4,BASE']).send('creator'),
+            () => createSynth(synth = nextSynth()),
+        );
+    });
+
+    it('should profile base deposit', async () => {
+        await useBaseline();
+        await measure('deposit', RUNS, () =>
+            totems.actions.transfer(['creator', 'mirror', '1.0000 BASE', '']).send('creator'));
+    });
+
+    it('should profile mint', async () => {
+        await useBaseline();
+        await measure(
+            'mint',
+            RUNS,
+            () => totems.actions.mint(['mirror', 'creator', '0.0000 SYNTH', '0.0000 A', '']).send('creator'),
+            () => totems.actions.transfer(['creator', 'mirror', '1.0000 BASE', '']).send('creator'),
+        );
+    });
+
+    it('should profile redemption', async () => {
+        await useBaseline();
+        await totems.actions.transfer(['creator', 'mirror', `${RUNS}.0000 BASE`, '']).send('creator');
+        await totems.actions.mint(['mirror', 'creator', '0.0000 SYNTH', '0.0000 A', '']).send('creator');
+        await measure('redeem', RUNS, () =>
+            totems.actions.transfer(['creator', 'mirror', '1.0000 SYNTH', '']).send('creator'));
+    });
+
+    // The read-only views over EXPORT_PAIRINGS pairings of one creator (plus the baseline's)
+    const EXPORT_PAIRINGS = Number(process.env.BENCH_PAIRINGS ?? 200);
+    const pairMany = async () => {
+        for (let i = 0; i < EXPORT_PAIRINGS; i++) {
+            const synth = nextSynth();
+            await createSynth(synth);
+            await mirror.actions.setup([`4,${synth}`, '4,BASE']).send('creator');
+        }
+    };
+
+    it('should profile export', async () => {
+        await useBaseline();
+        await pairMany();
+        await measure('export', RUNS, () => mirror.actions.export([0n, 5000]).send('user'));
+    });
+
+    it('should profile creatorinfo', async () => {
+        await useBaseline();
+        await pairMany();
+        await measure('creatorinfo', RUNS, () => mirror.actions.creatorinfo(['creator']).send('user'));
+    });
+});
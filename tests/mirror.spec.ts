@@ -1,69 +1,57 @@
-import { describe, it } from "node:test";
+import { beforeEach, describe, it } from "node:test";
 import assert from "node:assert";
 import {expectToThrow, nameToBigInt} from "@vaulta/vert";
 import {
     blockchain,
-    createAccount,
     createTotem,
     getTotemBalance,
-    MOCK_MOD_DETAILS,
-    MOD_HOOKS,
-    publishMod,
-    setup,
     totemMods, totems
 } from "./helpers";
-
-const mirror = blockchain.createContract('mirror', 'build/mirror', true);
-
+import { mirror, useBaseline } from "./fixtures";
+
+// Tables scoped by ticker use the raw symbol_code (first char in the lowest byte)
+const symbolCodeRaw = (code: string) =>
+    [...code].reduceRight((raw, c) => (raw << 8n) | BigInt(c.charCodeAt(0)), 0n);
+
+const pairing = (synth: string) =>
+    mirror.tables.pairings(nameToBigInt('mirror')).getTableRows().find(p => p.synth_ticker === synth)!;
+
+// A synth whose supply the mirror holds as minter, like SYNTH in the baseline
+const createSynth = (symbol: string) => createTotem(
+    symbol,
+    [{ recipient: 'mirror', quantity: 1_000_000_000, label: 'Synth supply', is_minter: true }],
+    totemMods({ transfer: ['mirror'], mint: ['mirror'] }),
+);
+
+const pairSynth = async (synth: string) => {
+    await createSynth(`4,${synth}`);
+    await mirror.actions.setup([`4,${synth}`, '4,BASE']).send('creator');
+};
+
+// Creator deposit followed by the mint that picks it up
+const mintSynth = async (synth: string, amount: number) => {
+    await totems.actions.transfer(['creator', 'mirror', `${amount}.0000 BASE`, '']).send('creator');
+    await totems.actions.mint(['mirror', 'creator', `0.0000 ${synth}`, '0.0000 A', '']).send('creator');
+};
+
+const redeem = (from: string, amount: number, synth: string) =>
+    totems.actions.transfer([from, 'mirror', `${amount}.0000 ${synth}`, '']).send(from);
+
+// `user` sends BASE they got from the creator to the mirror, which records it as theirs
+const userDeposit = async (amount: number) => {
+    await totems.actions.transfer(['creator', 'user', `${amount}.0000 BASE`, '']).send('creator');
+    await totems.actions.transfer(['user', 'mirror', `${amount}.0000 BASE`, '']).send('user');
+};
+
+// Every case starts from the baseline (SYNTH paired to BASE, nothing minted) and sets up the rest itself
 describe('Mirror', () => {
-    it('should setup tests', async () => {
-        await setup();
-        await createAccount('seller');
-        await createAccount('creator');
-        await createAccount('user');
-    });
-
-    it('should be able to publish the mirror mod', async () => {
-        await publishMod(
-            'seller',
-            'mirror',
-            [
-                MOD_HOOKS.Transfer,
-                MOD_HOOKS.Mint,
-            ],
-            0,
-            MOCK_MOD_DETAILS(true),
-        );
+    beforeEach(async () => {
+        await useBaseline();
     });
 
-    it('should create a base totem and a synth totem', async () => {
-        // Base totem: creator gets allocation
-        await createTotem(
-            '4,BASE',
-            [
-                { recipient: 'creator', quantity: 1_000_000_000, label: 'Creator allocation', is_minter: false },
-            ],
-            totemMods({}),
-        );
-
-        // Synth totem: mirror mod gets allocation as minter
-        await createTotem(
-            '4,SYNTH',
-            [
-                { recipient: 'mirror', quantity: 1_000_000_000, label: 'Synth supply', is_minter: true },
-            ],
-            totemMods({
-                transfer: ['mirror'],
-                mint: ['mirror'],
-            }),
-        );
-
+    it('should start from a paired baseline', async () => {
         assert(getTotemBalance('creator', 'BASE') === 1_000_000_000, 'Creator should have 1b BASE');
         assert(getTotemBalance('mirror', 'SYNTH') === 1_000_000_000, 'Mirror mod should have 1b SYNTH');
-    });
-
-    it('should setup the pairing', async () => {
-        await mirror.actions.setup(['4,SYNTH', '4,BASE']).send('creator');
 
         const pairings = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
         assert(pairings.length === 1, 'Should have 1 pairing');
@@ -71,8 +59,9 @@ describe('Mirror', () => {
     });
 
     it('should not allow non-creator to setup', async () => {
+        await createSynth('4,SYNTH2');
         await expectToThrow(
-            mirror.actions.setup(['4,SYNTH', '4,BASE']).send('user'),
+            mirror.actions.setup(['4,SYNTH2', '4,BASE']).send('user'),
             "missing required authority creator"
         );
     });
@@ -85,25 +74,15 @@ describe('Mirror', () => {
     });
 
     it('should mint synth tokens when creator deposits base tokens', async () => {
-        // Step 1: Creator deposits base tokens to the mirror mod
-        await totems.actions.transfer(['creator', 'mirror', '100.0000 BASE', '']).send('creator');
+        await mintSynth('SYNTH', 100);
 
-        // Step 2: Creator calls mint for the synth totem
-        await totems.actions.mint(['mirror', 'creator', '0.0000 SYNTH', '0.0000 A', '']).send('creator');
-
-        // Creator should have received 100 SYNTH tokens
         const synthBalance = getTotemBalance('creator', 'SYNTH');
         assert(synthBalance === 100, `Expected 100 SYNTH, got ${synthBalance}`);
-
-        // Reserves should track the deposit
-        const pairings = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
-        assert(pairings[0].base_locked === '100.0000 BASE', `Expected base_locked to be 100.0000 BASE, got ${pairings[0].base_locked}`);
+        assert(pairing('SYNTH').base_locked === '100.0000 BASE', `Expected base_locked to be 100.0000 BASE, got ${pairing('SYNTH').base_locked}`);
     });
 
     it('should not allow non-creator to mint synths', async () => {
-        // User deposits base tokens (first give user some BASE)
-        await totems.actions.transfer(['creator', 'user', '50.0000 BASE', '']).send('creator');
-        await totems.actions.transfer(['user', 'mirror', '50.0000 BASE', '']).send('user');
+        await userDeposit(50);
 
         await expectToThrow(
             totems.actions.mint(['mirror', 'user', '0.0000 SYNTH', '0.0000 A', '']).send('user'),
@@ -112,125 +91,278 @@ describe('Mirror', () => {
     });
 
     it('should allow anyone to redeem synths for base tokens', async () => {
-        // Give user some synth tokens
+        await mintSynth('SYNTH', 100);
         await totems.actions.transfer(['creator', 'user', '50.0000 SYNTH', '']).send('creator');
 
         const userBaseBefore = getTotemBalance('user', 'BASE');
+        await redeem('user', 50, 'SYNTH');
 
-        // User redeems synths by transferring to mirror mod
-        await totems.actions.transfer(['user', 'mirror', '50.0000 SYNTH', '']).send('user');
-
-        // User should have received 50 base tokens
         const userBaseAfter = getTotemBalance('user', 'BASE');
         assert(userBaseAfter - userBaseBefore === 50, `Expected user to gain 50 BASE, got ${userBaseAfter - userBaseBefore}`);
+        assert(getTotemBalance('user', 'SYNTH') === 0, `Expected 0 SYNTH for user, got ${getTotemBalance('user', 'SYNTH')}`);
+        assert(pairing('SYNTH').base_locked === '50.0000 BASE', `Expected base_locked to be 50.0000 BASE, got ${pairing('SYNTH').base_locked}`);
+    });
 
-        // Synth tokens should be burned (user balance should be 0)
-        const userSynth = getTotemBalance('user', 'SYNTH');
-        assert(userSynth === 0, `Expected 0 SYNTH for user, got ${userSynth}`);
+    it('should redeem the whole reserve', async () => {
+        // Synths in circulation always equal the reserve, so redeeming all of them empties it
+        await mintSynth('SYNTH', 50);
+        await redeem('creator', 50, 'SYNTH');
+        assert(pairing('SYNTH').base_locked === '0.0000 BASE', `Expected base_locked to be 0.0000 BASE, got ${pairing('SYNTH').base_locked}`);
+    });
 
-        // Reserves should have decreased
-        const pairings = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
-        // 100 locked originally + 50 deposited by user (not yet minted) - 50 redeemed = 100
-        // Actually, the non-creator deposit of 50 was never minted (auth check failed), so it's still untracked
-        // The locked was 100, now minus 50 redeemed = 50
-        assert(pairings[0].base_locked === '50.0000 BASE', `Expected base_locked to be 50.0000 BASE, got ${pairings[0].base_locked}`);
+    it('should support multiple synths backed by the same base', async () => {
+        await pairSynth('SYNTH2');
+        await mintSynth('SYNTH2', 200);
+
+        const synth2Balance = getTotemBalance('creator', 'SYNTH2');
+        assert(synth2Balance === 200, `Expected 200 SYNTH2, got ${synth2Balance}`);
+        assert(pairing('SYNTH').base_locked === '0.0000 BASE', `SYNTH base_locked should be 0, got ${pairing('SYNTH').base_locked}`);
+        assert(pairing('SYNTH2').base_locked === '200.0000 BASE', `SYNTH2 base_locked should be 200, got ${pairing('SYNTH2').base_locked}`);
     });
 
-    it('should fail to redeem more than locked reserves', async () => {
-        // Creator still has 50 SYNTH. Try to redeem more than the 50 locked.
-        // First let's check how much the creator has
-        const creatorSynth = getTotemBalance('creator', 'SYNTH');
+    it('should correctly handle mint with multiple synths sharing the same base', async () => {
+        await pairSynth('SYNTH2');
+        await mintSynth('SYNTH2', 200);
+        await mintSynth('SYNTH', 75);
 
-        // The creator minted 100, sent 50 to user, has 50 left. Reserves are 50.
-        // Try to redeem 51 SYNTH (but creator only has 50, and reserves are also 50)
-        // Let's just try the exact 50 + ensure we can't go beyond
-        // Actually we need a scenario where someone has more synths than reserves
-        // This is impossible in normal flow since synths == reserves always, but let's verify the check
+        const synthBalance = getTotemBalance('creator', 'SYNTH');
+        assert(synthBalance === 75, `Expected 75 SYNTH, got ${synthBalance}`);
+        assert(pairing('SYNTH').base_locked === '75.0000 BASE', `SYNTH base_locked should be 75, got ${pairing('SYNTH').base_locked}`);
+        assert(pairing('SYNTH2').base_locked === '200.0000 BASE', `SYNTH2 base_locked should still be 200, got ${pairing('SYNTH2').base_locked}`);
+    });
 
-        // Redeem all remaining 50
-        await totems.actions.transfer(['creator', 'mirror', '50.0000 SYNTH', '']).send('creator');
+    it('should redeem SYNTH2 independently', async () => {
+        await pairSynth('SYNTH2');
+        await mintSynth('SYNTH2', 200);
+        await mintSynth('SYNTH', 75);
+        await redeem('creator', 100, 'SYNTH2');
 
-        // Now reserves should be 0
-        const pairings = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
-        assert(pairings[0].base_locked === '0.0000 BASE', `Expected base_locked to be 0.0000 BASE, got ${pairings[0].base_locked}`);
+        assert(pairing('SYNTH').base_locked === '75.0000 BASE', `SYNTH base_locked should still be 75, got ${pairing('SYNTH').base_locked}`);
+        assert(pairing('SYNTH2').base_locked === '100.0000 BASE', `SYNTH2 base_locked should be 100, got ${pairing('SYNTH2').base_locked}`);
     });
 
-    it('should support multiple synths backed by the same base', async () => {
-        // Create a second synth totem backed by the same BASE
+    it('should reject mismatched precision in setup', async () => {
         await createTotem(
-            '4,SYNTH2',
-            [
-                { recipient: 'mirror', quantity: 1_000_000_000, label: 'Synth2 supply', is_minter: true },
-            ],
-            totemMods({
-                transfer: ['mirror'],
-                mint: ['mirror'],
-            }),
+            '2,BADSYNTH',
+            [{ recipient: 'mirror', quantity: 1_000_000, label: 'Bad synth', is_minter: true }],
+            totemMods({ transfer: ['mirror'], mint: ['mirror'] }),
         );
 
-        await mirror.actions.setup(['4,SYNTH2', '4,BASE']).send('creator');
+        await expectToThrow(
+            mirror.actions.setup(['2,BADSYNTH', '4,BASE']).send('creator'),
+            "eosio_assert: Synth and base tickers must have the same precision"
+        );
+    });
 
-        // Deposit base tokens and mint SYNTH2
-        await totems.actions.transfer(['creator', 'mirror', '200.0000 BASE', '']).send('creator');
-        await totems.actions.mint(['mirror', 'creator', '0.0000 SYNTH2', '0.0000 A', '']).send('creator');
+    it('should migrate pairings in bounded steps', async () => {
+        await pairSynth('SYNTH2');
+        await mintSynth('SYNTH', 75);
+        await mintSynth('SYNTH2', 200);
+        const before = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
 
-        const synth2Balance = getTotemBalance('creator', 'SYNTH2');
-        assert(synth2Balance === 200, `Expected 200 SYNTH2, got ${synth2Balance}`);
+        // Two pairings, one row per call
+        await mirror.actions.migrate([1]).send('user');
+        let state = mirror.tables.migrations(nameToBigInt('mirror')).getTableRows()[0];
+        assert(state.version === 0, `Migration should still be running, got version ${state.version}`);
 
-        // Verify pairings are independent
-        const pairings = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
-        const synth1Pairing = pairings.find(p => p.base_locked.includes('BASE') && p.synth_ticker === 'SYNTH');
-        const synth2Pairing = pairings.find(p => p.base_locked.includes('BASE') && p.synth_ticker === 'SYNTH2');
+        await mirror.actions.migrate([1]).send('user');
+        state = mirror.tables.migrations(nameToBigInt('mirror')).getTableRows()[0];
+        assert(state.version === 3, `Migration should be complete, got version ${state.version}`);
 
-        assert(synth1Pairing!.base_locked === '0.0000 BASE', `SYNTH base_locked should be 0, got ${synth1Pairing!.base_locked}`);
-        assert(synth2Pairing!.base_locked === '200.0000 BASE', `SYNTH2 base_locked should be 200, got ${synth2Pairing!.base_locked}`);
+        await expectToThrow(
+            mirror.actions.migrate([1]).send('user'),
+            "eosio_assert: Migration already complete"
+        );
+
+        const after = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
+        for (const row of before) {
+            const migrated = after.find(p => p.synth_ticker === row.synth_ticker);
+            assert(migrated!.base_locked === row.base_locked, `Migration changed ${row.synth_ticker} reserves`);
+        }
     });
 
-    it('should correctly handle mint with multiple synths sharing the same base', async () => {
-        // Now deposit more base and mint for SYNTH (first synth)
-        await totems.actions.transfer(['creator', 'mirror', '75.0000 BASE', '']).send('creator');
-        await totems.actions.mint(['mirror', 'creator', '0.0000 SYNTH', '0.0000 A', '']).send('creator');
+    it('should list pairings per creator', async () => {
+        await pairSynth('SYNTH2');
 
-        const synthBalance = getTotemBalance('creator', 'SYNTH');
-        // creator previously had 0 SYNTH (all redeemed), now should have 75
-        assert(synthBalance === 75, `Expected 75 SYNTH, got ${synthBalance}`);
+        const aggregate = mirror.tables.creators(nameToBigInt('mirror')).getTableRows();
+        assert(aggregate.length === 1, `Expected 1 creator, got ${aggregate.length}`);
+        assert(aggregate[0].creator === 'creator', `Expected creator, got ${aggregate[0].creator}`);
+        assert(aggregate[0].pairings === 2, `Expected 2 pairings, got ${aggregate[0].pairings}`);
 
-        // SYNTH pairing should now show 75 locked, SYNTH2 should still show 200
-        const pairings = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
-        const synth1Pairing = pairings.find(p => p.synth_ticker === 'SYNTH');
-        const synth2Pairing = pairings.find(p => p.synth_ticker === 'SYNTH2');
+        const view = mirror.tables.creatorpairs(nameToBigInt('creator')).getTableRows();
+        const synths = view.map(row => row.synth_ticker).sort();
+        assert(synths.join() === 'SYNTH,SYNTH2', `Expected SYNTH and SYNTH2, got ${synths.join()}`);
+        assert(view.every(row => row.base_ticker === 'BASE'), 'Both pairings are backed by BASE');
 
-        assert(synth1Pairing!.base_locked === '75.0000 BASE', `SYNTH base_locked should be 75, got ${synth1Pairing!.base_locked}`);
-        assert(synth2Pairing!.base_locked === '200.0000 BASE', `SYNTH2 base_locked should still be 200, got ${synth2Pairing!.base_locked}`);
+        const others = mirror.tables.creatorpairs(nameToBigInt('user')).getTableRows();
+        assert(others.length === 0, 'Other creators should have no pairings');
     });
 
-    it('should redeem SYNTH2 independently', async () => {
-        await totems.actions.transfer(['creator', 'mirror', '100.0000 SYNTH2', '']).send('creator');
+    it('should summarize a creator', async () => {
+        const summary = async (creator: string) => {
+            await mirror.actions.creatorinfo([creator]).send(creator);
+            return blockchain.actionTraces.at(-1)!.decodedReturnValue;
+        };
 
-        const pairings = mirror.tables.pairings(nameToBigInt('mirror')).getTableRows();
-        const synth1Pairing = pairings.find(p => p.synth_ticker === 'SYNTH');
-        const synth2Pairing = pairings.find(p => p.synth_ticker === 'SYNTH2');
+        // Two synths on BASE and one on a second base
+        await pairSynth('SYNTH2');
+        await mintSynth('SYNTH', 75);
+        await mintSynth('SYNTH2', 200);
+        await createTotem(
+            '4,OTHER',
+            [{ recipient: 'creator', quantity: 1_000_000_000, label: 'Creator allocation', is_minter: false }],
+            totemMods({}),
+        );
+        await createSynth('4,SYNTHO');
+        await mirror.actions.setup(['4,SYNTHO', '4,OTHER']).send('creator');
+        await totems.actions.transfer(['creator', 'mirror', '30.0000 OTHER', '']).send('creator');
+        await totems.actions.mint(['mirror', 'creator', '0.0000 SYNTHO', '0.0000 A', '']).send('creator');
+
+        const info = await summary('creator');
+        assert(info.pairing_count === 3, `Expected 3 pairings, got ${info.pairing_count}`);
+        const synths = info.pairings.map((p: { synth_ticker: string }) => p.synth_ticker).sort();
+        assert(synths.join() === 'SYNTH,SYNTH2,SYNTHO', `Expected SYNTH, SYNTH2 and SYNTHO, got ${synths.join()}`);
+
+        // One total per base
+        const totals = [...info.locked_per_base].sort().join();
+        assert(totals === '275.0000 BASE,30.0000 OTHER', `Expected 275.0000 BASE and 30.0000 OTHER, got ${totals}`);
+
+        const empty = await summary('user');
+        assert(empty.pairing_count === 0 && empty.pairings.length === 0 && empty.locked_per_base.length === 0,
+            'A creator without pairings should have an empty summary');
+    });
 
-        assert(synth1Pairing!.base_locked === '75.0000 BASE', `SYNTH base_locked should still be 75, got ${synth1Pairing!.base_locked}`);
-        assert(synth2Pairing!.base_locked === '100.0000 BASE', `SYNTH2 base_locked should be 100, got ${synth2Pairing!.base_locked}`);
+    it('should export pairings in pages', async () => {
+        const exportPage = async (cursor: bigint, limit: number) => {
+            await mirror.actions.export([cursor, limit]).send('user');
+            return blockchain.actionTraces.at(-1)!.decodedReturnValue;
+        };
+        // `records` is ABI bytes: a hex string or a byte array depending on how it is decoded
+        const recordCount = (records: string | Uint8Array) =>
+            (typeof records === 'string' ? records.length / 2 : records.length) / 32;
+
+        await pairSynth('SYNTH2');
+        await mintSynth('SYNTH', 75);
+        await mintSynth('SYNTH2', 200);
+
+        const first = await exportPage(0n, 1);
+        assert(recordCount(first.records) === 1, 'A page holds at most `limit` records');
+        assert(first.more, 'SYNTH2 is still to come');
+        assert(BigInt(first.next_cursor) === symbolCodeRaw('SYNTH2'), `Expected SYNTH2 next, got ${first.next_cursor}`);
+        assert(first.locked_per_base.join() === '75.0000 BASE', `Expected SYNTH's 75.0000 BASE, got ${first.locked_per_base.join()}`);
+
+        const second = await exportPage(BigInt(first.next_cursor), 1);
+        assert(recordCount(second.records) === 1 && !second.more, 'SYNTH2 is the last page');
+        assert(second.locked_per_base.join() === '200.0000 BASE', `Expected SYNTH2's 200.0000 BASE, got ${second.locked_per_base.join()}`);
+
+        // A limit past the cap is clamped to a page, not rejected
+        const all = await exportPage(0n, 4_294_967_295);
+        assert(recordCount(all.records) === 2 && !all.more, 'One page should hold every pairing');
+        assert(all.locked_per_base.join() === '275.0000 BASE', `Expected 275.0000 BASE locked, got ${all.locked_per_base.join()}`);
+
+        await expectToThrow(exportPage(0n, 0), "eosio_assert: Limit must be positive");
     });
 
-    it('should reject mismatched precision in setup', async () => {
-        // Create a totem with different precision
-        await createTotem(
-            '2,BADSYNTH',
-            [
-                { recipient: 'mirror', quantity: 1_000_000, label: 'Bad synth', is_minter: true },
-            ],
-            totemMods({
-                transfer: ['mirror'],
-                mint: ['mirror'],
-            }),
+    it('should track per-pairing activity', async () => {
+        await pairSynth('SYNTH2');
+
+        // SYNTH: minted 100 then 75, redeemed 50 twice
+        await mintSynth('SYNTH', 100);
+        await totems.actions.transfer(['creator', 'user', '50.0000 SYNTH', '']).send('creator');
+        await redeem('user', 50, 'SYNTH');
+        await redeem('creator', 50, 'SYNTH');
+        await mintSynth('SYNTH', 75);
+        // SYNTH2: minted 200, redeemed 100
+        await mintSynth('SYNTH2', 200);
+        await redeem('creator', 100, 'SYNTH2');
+
+        const synth1 = pairing('SYNTH').stats;
+        assert(Number(synth1.mints) === 2, `Expected 2 SYNTH mints, got ${synth1.mints}`);
+        assert(Number(synth1.minted) === 1_750_000, `Expected 175 SYNTH minted, got ${synth1.minted}`);
+        assert(Number(synth1.redemptions) === 2, `Expected 2 SYNTH redemptions, got ${synth1.redemptions}`);
+        assert(Number(synth1.redeemed) === 1_000_000, `Expected 100 SYNTH redeemed, got ${synth1.redeemed}`);
+
+        const synth2 = pairing('SYNTH2').stats;
+        assert(Number(synth2.mints) === 1, `Expected 1 SYNTH2 mint, got ${synth2.mints}`);
+        assert(Number(synth2.minted) === 2_000_000, `Expected 200 SYNTH2 minted, got ${synth2.minted}`);
+        assert(Number(synth2.redemptions) === 1, `Expected 1 SYNTH2 redemption, got ${synth2.redemptions}`);
+        assert(Number(synth2.redeemed) === 1_000_000, `Expected 100 SYNTH2 redeemed, got ${synth2.redeemed}`);
+    });
+
+    it('should record base deposits from non-creators', async () => {
+        await userDeposit(50);
+
+        const deposits = mirror.tables.deposits(symbolCodeRaw('BASE')).getTableRows();
+        assert(deposits.length === 1, `Expected 1 deposit, got ${deposits.length}`);
+        assert(deposits[0].depositor === 'user', `Expected user deposit, got ${deposits[0].depositor}`);
+        assert(deposits[0].amount === '50.0000 BASE', `Expected 50.0000 BASE, got ${deposits[0].amount}`);
+
+        const unclaimed = mirror.tables.unclaimed(nameToBigInt('mirror')).getTableRows();
+        assert(unclaimed[0].total === '50.0000 BASE', `Expected 50.0000 BASE unclaimed, got ${unclaimed[0].total}`);
+
+        // A recorded deposit is not the creator's to mint against
+        await expectToThrow(
+            totems.actions.mint(['mirror', 'creator', '0.0000 SYNTH', '0.0000 A', '']).send('creator'),
+            "eosio_assert: No new base tokens deposited for minting synths"
+        );
+    });
+
+    it('should leave deposits below the minimum untracked', async () => {
+        await totems.actions.transfer(['creator', 'user', '1.0000 BASE', '']).send('creator');
+        await totems.actions.transfer(['user', 'mirror', '0.9999 BASE', '']).send('user');
+
+        assert(mirror.tables.deposits(symbolCodeRaw('BASE')).getTableRows().length === 0, 'Dust should not get a deposit row');
+        assert(mirror.tables.unclaimed(nameToBigInt('mirror')).getTableRows().length === 0, 'Dust should not be unclaimed');
+
+        // Untracked, so it backs the creator's next mint
+        await mintSynth('SYNTH', 100);
+        assert(pairing('SYNTH').base_locked === '100.9999 BASE', `Expected 100.9999 BASE locked, got ${pairing('SYNTH').base_locked}`);
+
+        // The minimum itself is recorded
+        await userDeposit(1);
+        const deposits = mirror.tables.deposits(symbolCodeRaw('BASE')).getTableRows();
+        assert(deposits.length === 1 && deposits[0].amount === '1.0000 BASE', `Expected a 1.0000 BASE deposit, got ${JSON.stringify(deposits)}`);
+    });
+
+    it('should only let the depositor refund', async () => {
+        await userDeposit(50);
+        await expectToThrow(
+            mirror.actions.refund(['BASE', 'user']).send('creator'),
+            "missing required authority user"
         );
+    });
+
+    it('should refund a recorded deposit', async () => {
+        await userDeposit(50);
+
+        const userBaseBefore = getTotemBalance('user', 'BASE');
+        await mirror.actions.refund(['BASE', 'user']).send('user');
+
+        const userBaseAfter = getTotemBalance('user', 'BASE');
+        assert(userBaseAfter - userBaseBefore === 50, `Expected user to get 50 BASE back, got ${userBaseAfter - userBaseBefore}`);
+        assert(mirror.tables.deposits(symbolCodeRaw('BASE')).getTableRows().length === 0, 'Deposit should be settled');
+        assert(mirror.tables.unclaimed(nameToBigInt('mirror')).getTableRows().length === 0, 'Unclaimed total should be cleared');
 
         await expectToThrow(
-            mirror.actions.setup(['2,BADSYNTH', '4,BASE']).send('creator'),
-            "eosio_assert: Synth and base tickers must have the same precision"
+            mirror.actions.refund(['BASE', 'user']).send('user'),
+            "eosio_assert: No deposit recorded for this account"
         );
     });
+
+    it('should let the creator sweep a deposit into the next mint', async () => {
+        await userDeposit(10);
+
+        await expectToThrow(
+            mirror.actions.sweep(['BASE', 'user']).send('user'),
+            "missing required authority creator"
+        );
+
+        await mirror.actions.sweep(['BASE', 'user']).send('creator');
+        assert(mirror.tables.deposits(symbolCodeRaw('BASE')).getTableRows().length === 0, 'Deposit should be settled');
+
+        const synthBefore = getTotemBalance('creator', 'SYNTH');
+        await totems.actions.mint(['mirror', 'creator', '0.0000 SYNTH', '0.0000 A', '']).send('creator');
+        const synthAfter = getTotemBalance('creator', 'SYNTH');
+        assert(synthAfter - synthBefore === 10, `Expected 10 SYNTH from the swept deposit, got ${synthAfter - synthBefore}`);
+    });
 });
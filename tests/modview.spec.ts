@@ -0,0 +1,75 @@
+import { describe, it } from "node:test";
+import {expectToThrow} from "@vaulta/vert";
+import {
+    blockchain,
+    createAccount,
+    MOCK_MOD_DETAILS,
+    MOD_HOOKS,
+    publishMod,
+    setup,
+} from "./helpers";
+
+// tests/contracts/modprobe.cpp: compares totems::mod_view against get_mod on the same row
+const probe = blockchain.createContract('modprobe', 'build/test/modprobe', true);
+
+const field = (param: string, type: number, data: string, offset: number, size: number) =>
+    ({ param, type, data, offset, size, min: null, max: null });
+
+const requiredAction = (contract: string, action: string, purpose: string, fields: ReturnType<typeof field>[]) =>
+    ({ contract, action, fields, purpose });
+
+describe('Mod view', () => {
+    it('should setup tests', async () => {
+        await setup();
+        await createAccount('seller');
+        await createAccount('probedmod');
+
+        // Several hooks, each with a different number of required actions, so walking to any one
+        // hook has to skip over the others' variable-length entries
+        await publishMod(
+            'seller',
+            'probedmod',
+            [MOD_HOOKS.Transfer, MOD_HOOKS.Mint, MOD_HOOKS.Burn],
+            0,
+            MOCK_MOD_DETAILS(false),
+            [
+                {
+                    hook: MOD_HOOKS.Transfer,
+                    actions: [
+                        requiredAction('eosio', 'buyrambytes', 'RAM for transfer records', [
+                            field('payer', 0, '', 0, 8),
+                            field('receiver', 2, '0000000000ea3055', 8, 8),
+                            field('bytes', 2, '00040000', 16, 4),
+                        ]),
+                        requiredAction('probedmod', 'open', 'Open a balance', []),
+                    ],
+                },
+                {
+                    hook: MOD_HOOKS.Mint,
+                    actions: [
+                        requiredAction('probedmod', 'register', 'Register the minter', [
+                            field('ticker', 3, '', 0, 8),
+                        ]),
+                    ],
+                },
+            ],
+        );
+    });
+
+    it('should decode every hook the same way as get_mod', async () => {
+        for (const hook of [MOD_HOOKS.Transfer, MOD_HOOKS.Mint, MOD_HOOKS.Burn]) {
+            await probe.actions.compare(['probedmod', hook]).send('modprobe');
+        }
+    });
+
+    it('should agree on hooks the mod does not have', async () => {
+        await probe.actions.compare(['probedmod', MOD_HOOKS.Created]).send('modprobe');
+    });
+
+    it('should reject unpublished mods', async () => {
+        await expectToThrow(
+            probe.actions.compare(['seller', MOD_HOOKS.Transfer]).send('modprobe'),
+            "eosio_assert: Mod is not published in market"
+        );
+    });
+});
@@ -0,0 +1,199 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+import {expectToThrow, nameToBigInt} from "@vaulta/vert";
+import {
+    blockchain,
+    createAccount,
+    createTotem,
+    getTotemBalance,
+    MOCK_MOD_DETAILS,
+    MOD_HOOKS,
+    publishMod,
+    setup,
+    totemMods, totems
+} from "./helpers";
+
+// Shards are mirror.cpp built with -DMIRROR_REGISTRY=\"registry\" (scripts/build-test.sh)
+const registry = blockchain.createContract('registry', 'build/test/registry', true);
+const pool = ['shardone', 'shardtwo', 'shardthree'];
+const shards = pool.map(
+    account => blockchain.createContract(account, 'build/test/mirror_sharded', true)
+);
+const bigShard = blockchain.createContract('shardbig', 'build/test/mirror_sharded', true);
+
+const symbolCodeRaw = (code: string) =>
+    [...code].reduceRight((raw, c) => (raw << 8n) | BigInt(c.charCodeAt(0)), 0n);
+
+// registry.cpp pick_shard for the shared pool, reproduced off-chain as the README says it can be
+const sharedShardFor = (ticker: string, shardPool: string[]) => {
+    let hash = (symbolCodeRaw(ticker) * 0x9E3779B97F4A7C15n) & 0xFFFFFFFFFFFFFFFFn;
+    hash ^= hash >> 32n;
+    return shardPool[Number(hash % BigInt(shardPool.length))];
+};
+
+// Synths are created against the shard `route` returned: it holds the supply and is their mods
+const createSynth = (ticker: string, shard?: string) => createTotem(
+    ticker,
+    shard
+        ? [{ recipient: shard, quantity: 1_000_000_000, label: 'Synth supply', is_minter: true }]
+        : [{ recipient: 'creator', quantity: 1_000_000, label: 'Synth supply', is_minter: false }],
+    totemMods(shard ? { transfer: [shard], mint: [shard] } : {}),
+);
+
+// The read-only `route` action, as a client calls it before creating the synth totem
+const route = async (synth: string, creator = 'creator'): Promise<string> => {
+    await registry.actions.route([synth, creator]).send(creator);
+    return String(blockchain.actionTraces.at(-1)!.decodedReturnValue);
+};
+
+const routeOf = (synth: string) =>
+    registry.tables.routes(nameToBigInt('registry')).getTableRows().find(r => r.synth_ticker === synth);
+
+// Shard `route` returned for SYNTHD before its creator was isolated
+let staleRoute = '';
+
+describe('Registry', () => {
+    it('should setup tests', async () => {
+        await setup();
+        await createAccount('seller');
+        await createAccount('creator');
+
+        for (const shard of [...shards, bigShard]) {
+            await publishMod('seller', shard.name.toString(), [MOD_HOOKS.Transfer, MOD_HOOKS.Mint], 0, MOCK_MOD_DETAILS(true));
+        }
+
+        await createTotem(
+            '4,BASE',
+            [{ recipient: 'creator', quantity: 1_000_000_000, label: 'Creator allocation', is_minter: false }],
+            totemMods({}),
+        );
+    });
+
+    it('should not route or provision before any shard is registered', async () => {
+        await expectToThrow(route('EARLY'), "eosio_assert: No shards registered");
+        await createSynth('4,EARLY');
+        await expectToThrow(
+            registry.actions.provision(['4,EARLY', '4,BASE']).send('creator'),
+            "eosio_assert: No shards registered"
+        );
+    });
+
+    it('should only let the registry add shards', async () => {
+        await expectToThrow(
+            registry.actions.addshard(['shardone']).send('creator'),
+            "missing required authority registry"
+        );
+        for (const shard of shards) {
+            await registry.actions.addshard([shard.name.toString()]).send('registry');
+        }
+        await expectToThrow(
+            registry.actions.addshard(['shardone']).send('registry'),
+            "eosio_assert: Shard is already in the shared pool"
+        );
+    });
+
+    it('should provision a pairing on the routed shard', async () => {
+        const picked = await route('SYNTH');
+        assert(pool.includes(picked), `SYNTH should be routed into the shared pool, got ${picked}`);
+        assert(picked === sharedShardFor('SYNTH', pool), `route disagrees with the off-chain hash: ${picked}`);
+
+        await createSynth('4,SYNTH', picked);
+        await registry.actions.provision(['4,SYNTH', '4,BASE']).send('creator');
+
+        const recorded = routeOf('SYNTH');
+        assert(recorded, 'SYNTH should be routed');
+        assert(recorded.shard === picked, `Provisioned on ${recorded.shard}, route said ${picked}`);
+        assert(await route('SYNTH') === picked, 'route should return the recorded shard');
+
+        const shard = shards.find(s => s.name.toString() === picked)!;
+        const pairings = shard.tables.pairings(nameToBigInt(picked)).getTableRows();
+        assert(pairings.length === 1, 'Routed shard should hold the pairing');
+        assert(pairings[0].base_ticker === 'BASE', `Expected BASE, got ${pairings[0].base_ticker}`);
+
+        for (const other of shards.filter(s => s !== shard)) {
+            const rows = other.tables.pairings(nameToBigInt(other.name.toString())).getTableRows();
+            assert(rows.length === 0, `${other.name} should not hold the pairing`);
+        }
+    });
+
+    it('should mint and redeem on the routed shard', async () => {
+        const shardName = await route('SYNTH');
+        const shard = shards.find(s => s.name.toString() === shardName)!;
+        const locked = () => shard.tables.pairings(nameToBigInt(shardName)).getTableRows()[0].base_locked;
+
+        const synthBefore = getTotemBalance('creator', 'SYNTH');
+        await totems.actions.transfer(['creator', shardName, '100.0000 BASE', '']).send('creator');
+        await totems.actions.mint([shardName, 'creator', '0.0000 SYNTH', '0.0000 A', '']).send('creator');
+        assert(getTotemBalance('creator', 'SYNTH') - synthBefore === 100, 'Mint should issue 100 SYNTH');
+        assert(locked() === '100.0000 BASE', `Expected 100.0000 BASE locked, got ${locked()}`);
+
+        const baseBefore = getTotemBalance('creator', 'BASE');
+        await totems.actions.transfer(['creator', shardName, '40.0000 SYNTH', '']).send('creator');
+        assert(getTotemBalance('creator', 'BASE') - baseBefore === 40, 'Redemption should return 40 BASE');
+        assert(locked() === '60.0000 BASE', `Expected 60.0000 BASE locked, got ${locked()}`);
+    });
+
+    it('should not provision the same synth twice', async () => {
+        await expectToThrow(
+            registry.actions.provision(['4,SYNTH', '4,BASE']).send('creator'),
+            "eosio_assert: Synth ticker is already routed"
+        );
+    });
+
+    it('should not allow setup on a shard directly', async () => {
+        await createSynth('4,SYNTHB');
+        await expectToThrow(
+            shards[0].actions.setup(['4,SYNTHB', '4,BASE']).send('creator'),
+            "missing required authority registry"
+        );
+    });
+
+    it('should route an isolated creator to their own shard', async () => {
+        const before = await route('SYNTH');
+        // Asked before the isolation, as a client that created SYNTHD then would have
+        staleRoute = await route('SYNTHD');
+        assert(pool.includes(staleRoute), `Unrouted synths go to the shared pool, got ${staleRoute}`);
+
+        await registry.actions.isolate(['creator', 'shardbig']).send('registry');
+        assert(await route('SYNTHC') === 'shardbig', 'Unrouted synths of an isolated creator go to their shard');
+        assert(await route('SYNTHC', 'seller') !== 'shardbig', 'Other creators stay on the shared pool');
+        assert(await route('SYNTH') === before, 'A routed synth keeps its shard after isolation');
+
+        await expectToThrow(
+            registry.actions.isolate(['seller', 'shardbig']).send('registry'),
+            "eosio_assert: Shard is already isolated to another creator"
+        );
+        await expectToThrow(
+            registry.actions.addshard(['shardbig']).send('registry'),
+            "eosio_assert: Shard is already isolated to a creator"
+        );
+
+        await createSynth('4,SYNTHC', 'shardbig');
+        await registry.actions.provision(['4,SYNTHC', '4,BASE']).send('creator');
+
+        assert(routeOf('SYNTHC')!.shard === 'shardbig', 'New synths should be routed to the isolated shard');
+        assert(await route('SYNTHC') === 'shardbig', 'route should return the isolated shard');
+        assert(routeOf('SYNTH')!.shard === before, 'Already routed synths must stay on their shard');
+        const pairings = bigShard.tables.pairings(nameToBigInt('shardbig')).getTableRows();
+        assert(pairings.length === 1 && pairings[0].synth_ticker === 'SYNTHC', 'Isolated shard should hold the pairing');
+    });
+
+    it('should not route a synth created against a stale route', async () => {
+        // Created against the shared pool shard `route` returned before the creator was isolated
+        await createSynth('4,SYNTHD', staleRoute);
+        await expectToThrow(
+            registry.actions.provision(['4,SYNTHD', '4,BASE']).send('creator'),
+            "eosio_assert: Synth totem must use its routed shard shardbig as mint and transfer mod"
+        );
+        assert(routeOf('SYNTHD') === undefined, 'No route should be recorded');
+    });
+
+    it('should keep existing routes when shards are added', async () => {
+        const before = await route('SYNTH');
+        await createAccount('shardfour');
+        await registry.actions.addshard(['shardfour']).send('registry');
+        assert(routeOf('SYNTH')!.shard === before, 'Existing routes must not move');
+        assert(await route('SYNTH') === before, 'route should still return the recorded shard');
+        assert(await route('SYNTHC') === 'shardbig', 'route should still return the isolated shard');
+    });
+});
@@ -0,0 +1,60 @@
+import { beforeEach, describe, it } from "node:test";
+import assert from "node:assert";
+import { readdirSync, readFileSync } from "node:fs";
+import { nameToBigInt } from "@vaulta/vert";
+import {
+    createTotem,
+    getTotemBalance,
+    totemMods, totems
+} from "./helpers";
+import { mirror, useBaseline } from "./fixtures";
+
+// Replays the transactions tools/tests/run.sh checks tools/tx_packer against
+// (tools/tests/fixtures/txs, packed from fixtures/manifest.txt with `--mirror mirror`),
+// so the golden files are known to be transactions the contracts accept, in that order.
+const TXS = 'tools/tests/fixtures/txs';
+
+type PackedAction = {
+    account: string,
+    name: string,
+    authorization: { actor: string }[],
+    data: Record<string, unknown>,
+};
+
+const contracts: Record<string, typeof mirror> = { mirror, totemstotems: totems };
+
+const pairing = (synth: string) =>
+    mirror.tables.pairings(nameToBigInt('mirror')).getTableRows().find(p => p.synth_ticker === synth)!;
+
+describe('tx_packer output', () => {
+    beforeEach(async () => {
+        await useBaseline();
+    });
+
+    it('should onboard the manifest when replayed', async () => {
+        for (const synth of ['SYNA', 'SYNB']) {
+            await createTotem(
+                `4,${synth}`,
+                [{ recipient: 'mirror', quantity: 1_000_000_000, label: 'Synth supply', is_minter: true }],
+                totemMods({ transfer: ['mirror'], mint: ['mirror'] }),
+            );
+        }
+
+        const files = readdirSync(TXS).filter(f => f.endsWith('.json')).sort();
+        assert(files.length === 3, `Expected 3 packed transactions, got ${files.length}`);
+        for (const file of files) {
+            const tx = JSON.parse(readFileSync(`${TXS}/${file}`, 'utf8'));
+            // One action at a time: the VM pushes actions, not packed transactions
+            for (const action of tx.actions as PackedAction[]) {
+                const actor = action.authorization[0].actor;
+                // `data` keeps the ABI field order, which is the action's argument order
+                await contracts[action.account].actions[action.name](Object.values(action.data)).send(actor);
+            }
+        }
+
+        assert(pairing('SYNA').base_locked === '100.5000 BASE', `Expected 100.5000 BASE behind SYNA, got ${pairing('SYNA').base_locked}`);
+        assert(pairing('SYNB').base_locked === '25.0000 BASE', `Expected 25.0000 BASE behind SYNB, got ${pairing('SYNB').base_locked}`);
+        assert(getTotemBalance('creator', 'SYNA') === 100.5, `Expected 100.5 SYNA minted, got ${getTotemBalance('creator', 'SYNA')}`);
+        assert(getTotemBalance('creator', 'SYNB') === 25, `Expected 25 SYNB minted, got ${getTotemBalance('creator', 'SYNB')}`);
+    });
+});
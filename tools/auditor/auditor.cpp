@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/mirror_rows.hpp"
+using namespace mirror_tools;
+
+/*
+ * Mirror Reserve Auditor
+ * ----------------
+ * Offline audit of a mirror deployment from table snapshots:
+ *   - the mirror account's `pairings` table
+ *   - the mirror account's scope of the totems `accounts` table (its balances)
+ *   - optionally the mirror account's `unclaimed` table (recorded non-creator deposits)
+ * All can be JSON (`cleos get table ...` output, pages concatenated) or binary
+ * (length-prefixed packed rows), see `mirror_rows.hpp`.
+ *
+ * For every base ticker it reports the total locked across pairings, the unclaimed ledger
+ * total, the mirror's actual balance and the untracked rest (creator deposits not yet
+ * minted: balance - locked - unclaimed), and flags any row or total that breaks the
+ * contract's invariants. Exits non-zero if anything is flagged. Without `--unclaimed`
+ * the ledger can't be separated out, so "untracked" also includes recorded deposits.
+ *
+ * usage: auditor --pairings <file> --accounts <file> [--unclaimed <file>] [--threads N]
+ * ----------------
+ */
+
+struct BaseTotals {
+    int64_t locked = 0;
+    uint64_t pairings = 0;
+    uint8_t precision = 0;
+    bool precision_mismatch = false;
+    bool overflow = false;
+};
+
+struct Partial {
+    std::unordered_map<uint64_t, BaseTotals> bases;
+    std::vector<uint64_t> synths;
+    std::vector<std::string> violations;
+};
+
+static void accumulate(Partial& out, const PairingRow& row) {
+    std::string synth = symbol_code_to_string(row.synth_ticker);
+    out.synths.push_back(row.synth_ticker);
+
+    if (row.base_locked.code != row.base_ticker) {
+        out.violations.push_back(synth + ": base_locked is denominated in " + symbol_code_to_string(row.base_locked.code) +
+                                 " but base_ticker is " + symbol_code_to_string(row.base_ticker));
+    }
+    if (row.base_locked.amount < 0) {
+        out.violations.push_back(synth + ": negative base_locked " + format_asset(row.base_locked));
+    }
+    if (row.synth_ticker == row.base_ticker) {
+        out.violations.push_back(synth + ": synth and base tickers are the same");
+    }
+
+    auto [it, inserted] = out.bases.try_emplace(row.base_ticker);
+    BaseTotals& totals = it->second;
+    if (inserted) {
+        totals.precision = row.base_locked.precision;
+    } else if (totals.precision != row.base_locked.precision) {
+        totals.precision_mismatch = true;
+    }
+    totals.pairings++;
+    if (__builtin_add_overflow(totals.locked, row.base_locked.amount, &totals.locked)) totals.overflow = true;
+}
+
+static void merge(Partial& into, Partial&& from) {
+    for (auto& [base, totals] : from.bases) {
+        auto [it, inserted] = into.bases.try_emplace(base, totals);
+        if (inserted) continue;
+        BaseTotals& dst = it->second;
+        dst.pairings += totals.pairings;
+        dst.overflow |= totals.overflow;
+        dst.precision_mismatch |= totals.precision_mismatch || dst.precision != totals.precision;
+        if (__builtin_add_overflow(dst.locked, totals.locked, &dst.locked)) dst.overflow = true;
+    }
+    into.synths.insert(into.synths.end(), from.synths.begin(), from.synths.end());
+    for (auto& v : from.violations) into.violations.push_back(std::move(v));
+}
+
+static Partial scan_pairings(std::string_view data, unsigned threads) {
+    std::vector<Partial> partials(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    std::vector<std::string_view> rows;
+    size_t chunk = 0;
+
+    // Runs `fn` on its own thread, keeping any exception for the caller
+    auto spawn = [&](unsigned t, auto fn) {
+        workers.emplace_back([&, t, fn] {
+            try {
+                fn();
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    };
+
+    // Row boundaries are only discoverable sequentially; framing is cheap next to decoding
+    bool json = is_json_snapshot(data);
+    rows = json ? split_json_rows(data) : split_binary_rows(data);
+    chunk = rows.size() / threads + 1;
+    for (unsigned t = 0; t < threads; ++t) {
+        spawn(t, [&, t] {
+            size_t begin = std::min(rows.size(), t * chunk);
+            size_t end = std::min(rows.size(), begin + chunk);
+            for (size_t i = begin; i < end; ++i) {
+                if (!json) {
+                    accumulate(partials[t], unpack_pairing(rows[i]));
+                } else if (auto row = parse_pairing_json(rows[i])) {
+                    accumulate(partials[t], *row);
+                } else {
+                    throw std::runtime_error("Pairing row without synth_ticker/base_ticker/base_locked: " + std::string(rows[i]));
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    Partial result;
+    for (auto& p : partials) merge(result, std::move(p));
+    return result;
+}
+
+static std::unordered_map<uint64_t, Asset> scan_balances(std::string_view data) {
+    std::unordered_map<uint64_t, Asset> balances;
+    if (is_json_snapshot(data)) {
+        for (auto object : split_json_rows(data)) {
+            if (auto row = parse_balance_json(object)) balances[row->balance.code] = row->balance;
+        }
+    } else {
+        for (auto row : split_binary_rows(data)) {
+            auto balance = unpack_balance(row).balance;
+            balances[balance.code] = balance;
+        }
+    }
+    return balances;
+}
+
+static std::unordered_map<uint64_t, Asset> scan_unclaimed(std::string_view data) {
+    std::unordered_map<uint64_t, Asset> unclaimed;
+    if (is_json_snapshot(data)) {
+        for (auto object : split_json_rows(data)) {
+            auto row = parse_unclaimed_json(object);
+            if (!row) throw std::runtime_error("Unclaimed row without base_ticker/total: " + std::string(object));
+            unclaimed[row->base_ticker] = row->total;
+        }
+    } else {
+        for (auto packed : split_binary_rows(data)) {
+            auto row = unpack_unclaimed(packed);
+            unclaimed[row.base_ticker] = row.total;
+        }
+    }
+    return unclaimed;
+}
+
+static int usage() {
+    std::fprintf(stderr, "usage: auditor --pairings <file> --accounts <file> [--unclaimed <file>] [--threads N]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string pairings_path, accounts_path, unclaimed_path;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return usage();
+        if (arg == "--pairings") pairings_path = argv[++i];
+        else if (arg == "--accounts") accounts_path = argv[++i];
+        else if (arg == "--unclaimed") unclaimed_path = argv[++i];
+        else if (arg == "--threads") threads = std::max(1, std::atoi(argv[++i]));
+        else return usage();
+    }
+    if (pairings_path.empty() || accounts_path.empty()) return usage();
+
+    try {
+        MappedFile pairings_file(pairings_path);
+        MappedFile accounts_file(accounts_path);
+
+        Partial audit = scan_pairings(pairings_file.view(), threads);
+        auto balances = scan_balances(accounts_file.view());
+        std::unordered_map<uint64_t, Asset> unclaimed;
+        if (!unclaimed_path.empty()) {
+            MappedFile unclaimed_file(unclaimed_path);
+            unclaimed = scan_unclaimed(unclaimed_file.view());
+        } else {
+            std::fprintf(stderr, "auditor: no --unclaimed snapshot, untracked includes recorded deposits\n");
+        }
+
+        std::sort(audit.synths.begin(), audit.synths.end());
+        for (auto it = std::adjacent_find(audit.synths.begin(), audit.synths.end()); it != audit.synths.end();
+             it = std::adjacent_find(std::upper_bound(it, audit.synths.end(), *it), audit.synths.end())) {
+            audit.violations.push_back(symbol_code_to_string(*it) + ": duplicate pairing rows");
+        }
+
+        // Sorted by ticker for stable, diffable output
+        std::map<std::string, std::pair<uint64_t, BaseTotals>> sorted;
+        for (auto& [base, totals] : audit.bases) sorted.emplace(symbol_code_to_string(base), std::make_pair(base, totals));
+
+        std::printf("%-8s %9s %24s %24s %24s %24s  %s\n", "base", "pairings", "locked", "unclaimed", "balance", "untracked",
+                    "status");
+        for (auto& [ticker, entry] : sorted) {
+            auto& [base, totals] = entry;
+            auto found = balances.find(base);
+            int64_t balance = found == balances.end() ? 0 : found->second.amount;
+            auto recorded = unclaimed.find(base);
+            int64_t ledger = recorded == unclaimed.end() ? 0 : recorded->second.amount;
+            int64_t owed = 0;
+            if (__builtin_add_overflow(totals.locked, ledger, &owed)) totals.overflow = true;
+            int64_t untracked = balance - owed;
+
+            std::string status = "ok";
+            if (totals.overflow) {
+                status = "LOCKED_OVERFLOW";
+                audit.violations.push_back(ticker + ": total locked overflows int64");
+            } else if (untracked < 0) {
+                status = "UNDER_RESERVED";
+                audit.violations.push_back(ticker + ": locked " + format_amount(totals.locked, totals.precision) +
+                                           " + unclaimed " + format_amount(ledger, totals.precision) +
+                                           " exceeds balance " + format_amount(balance, totals.precision));
+            }
+            if (totals.precision_mismatch) {
+                status = "PRECISION_MISMATCH";
+                audit.violations.push_back(ticker + ": pairings disagree on base precision");
+            } else if (found != balances.end() && found->second.precision != totals.precision) {
+                status = "PRECISION_MISMATCH";
+                audit.violations.push_back(ticker + ": balance precision differs from pairings");
+            }
+
+            std::string ledger_column = unclaimed_path.empty() ? "-" : format_amount(ledger, totals.precision);
+            std::printf("%-8s %9llu %24s %24s %24s %24s  %s\n", ticker.c_str(), (unsigned long long)totals.pairings,
+                        format_amount(totals.locked, totals.precision).c_str(), ledger_column.c_str(),
+                        format_amount(balance, totals.precision).c_str(),
+                        format_amount(untracked, totals.precision).c_str(), status.c_str());
+        }
+
+        std::printf("\n%zu pairings across %zu bases, %zu violations\n", audit.synths.size(), sorted.size(),
+                    audit.violations.size());
+        for (auto& v : audit.violations) std::printf("  ! %s\n", v.c_str());
+        return audit.violations.empty() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "auditor: %s\n", e.what());
+        return 2;
+    }
+}
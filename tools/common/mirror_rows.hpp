@@ -0,0 +1,503 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Off-chain Mirror Rows
+ * ----------------
+ * Host-side (non-wasm) mirrors of the on-chain rows the tools in this directory read,
+ * plus the small amount of Antelope binary/JSON handling they need. Nothing here links
+ * against CDT; layouts must be kept in sync with `contracts/mirror/mirror.cpp` and
+ * `contracts/library/totems.hpp` by hand.
+ * ----------------
+ */
+
+namespace mirror_tools {
+
+    /* ---------------- SYMBOLS & ASSETS ---------------- */
+
+    // eosio::symbol_code packs up to 7 chars, first char in the lowest byte.
+    // Digits are accepted since totem tickers (e.g. SYNTH2) use them.
+    inline uint64_t symbol_code_from_string(std::string_view str) {
+        if (str.empty() || str.size() > 7) throw std::runtime_error("Invalid symbol code: " + std::string(str));
+        uint64_t raw = 0;
+        for (size_t i = 0; i < str.size(); ++i) {
+            bool valid = (str[i] >= 'A' && str[i] <= 'Z') || (str[i] >= '0' && str[i] <= '9');
+            if (!valid) throw std::runtime_error("Invalid symbol code: " + std::string(str));
+            raw |= uint64_t(uint8_t(str[i])) << (8 * i);
+        }
+        return raw;
+    }
+
+    inline std::string symbol_code_to_string(uint64_t raw) {
+        std::string str;
+        for (; raw; raw >>= 8) str.push_back(char(raw & 0xff));
+        return str;
+    }
+
+    // eosio::name: 12 chars of [.1-5a-z] at 5 bits each, plus a 13th of 4 bits
+    inline uint64_t name_from_string(std::string_view str) {
+        if (str.size() > 13) throw std::runtime_error("Invalid name: " + std::string(str));
+        auto char_to_value = [&](char c) -> uint64_t {
+            if (c == '.') return 0;
+            if (c >= '1' && c <= '5') return uint64_t(c - '1') + 1;
+            if (c >= 'a' && c <= 'z') return uint64_t(c - 'a') + 6;
+            throw std::runtime_error("Invalid name: " + std::string(str));
+        };
+        uint64_t value = 0;
+        for (size_t i = 0; i < str.size(); ++i) {
+            uint64_t v = char_to_value(str[i]);
+            if (i < 12) {
+                value |= (v & 0x1f) << (64 - 5 * (i + 1));
+            } else {
+                if (v > 0x0f) throw std::runtime_error("Invalid name: " + std::string(str));
+                value |= v;
+            }
+        }
+        return value;
+    }
+
+    struct Asset {
+        int64_t amount = 0;
+        uint8_t precision = 0;
+        uint64_t code = 0;
+
+        // eosio::symbol packs the precision in the low byte and the code above it
+        uint64_t symbol_raw() const { return (code << 8) | precision; }
+        static Asset from_binary(int64_t amount, uint64_t symbol_raw) {
+            return Asset{amount, uint8_t(symbol_raw & 0xff), symbol_raw >> 8};
+        }
+    };
+
+    // Parses "100.0000 BASE" the way eosio::asset::from_string does
+    inline Asset parse_asset(std::string_view str) {
+        auto space = str.find(' ');
+        if (space == std::string_view::npos) throw std::runtime_error("Invalid asset: " + std::string(str));
+        auto amount_str = str.substr(0, space);
+        Asset out;
+        out.code = symbol_code_from_string(str.substr(space + 1));
+
+        bool negative = !amount_str.empty() && amount_str[0] == '-';
+        if (negative) amount_str.remove_prefix(1);
+        auto dot = amount_str.find('.');
+        out.precision = dot == std::string_view::npos ? 0 : uint8_t(amount_str.size() - dot - 1);
+
+        int64_t amount = 0;
+        for (char c : amount_str) {
+            if (c == '.') continue;
+            if (c < '0' || c > '9') throw std::runtime_error("Invalid asset: " + std::string(str));
+            amount = amount * 10 + (c - '0');
+        }
+        out.amount = negative ? -amount : amount;
+        return out;
+    }
+
+    // Parses a symbol ("4,BASE") into a zero amount carrying its precision and code
+    inline Asset parse_symbol(std::string_view str) {
+        auto comma = str.find(',');
+        if (comma == std::string_view::npos || comma == 0 || comma > 2) throw std::runtime_error("Invalid symbol: " + std::string(str));
+        int precision = 0;
+        for (char c : str.substr(0, comma)) {
+            if (c < '0' || c > '9') throw std::runtime_error("Invalid symbol: " + std::string(str));
+            precision = precision * 10 + (c - '0');
+        }
+        if (precision > 18) throw std::runtime_error("Invalid symbol precision: " + std::string(str));
+        return Asset{0, uint8_t(precision), symbol_code_from_string(str.substr(comma + 1))};
+    }
+
+    inline std::string format_amount(int64_t amount, uint8_t precision) {
+        bool negative = amount < 0;
+        uint64_t abs = negative ? uint64_t(-(amount + 1)) + 1 : uint64_t(amount);
+        std::string digits = std::to_string(abs);
+        if (precision > 0) {
+            if (digits.size() <= precision) digits.insert(0, precision - digits.size() + 1, '0');
+            digits.insert(digits.size() - precision, ".");
+        }
+        return negative ? "-" + digits : digits;
+    }
+
+    inline std::string format_asset(const Asset& a) {
+        return format_amount(a.amount, a.precision) + " " + symbol_code_to_string(a.code);
+    }
+
+    /* ---------------- ROWS ---------------- */
+
+    // mirror::Pairing (`pairings` table)
+    struct PairingRow {
+        uint64_t synth_ticker = 0;
+        uint64_t base_ticker = 0;
+        Asset base_locked;
+    };
+
+    // mirror::Unclaimed (`unclaimed` table): recorded non-creator deposits per base
+    struct UnclaimedRow {
+        uint64_t base_ticker = 0;
+        Asset total;
+    };
+
+    // totems::Balance (`accounts` table, scoped to the owner)
+    struct BalanceRow {
+        Asset balance;
+    };
+
+    /* ---------------- BINARY ---------------- */
+
+    // Minimal Antelope binary reader (little-endian, varuint32 lengths)
+    struct Reader {
+        const char* pos;
+        const char* end;
+
+        size_t remaining() const { return size_t(end - pos); }
+
+        void read(void* out, size_t len) {
+            if (remaining() < len) throw std::runtime_error("Unexpected end of binary data");
+            std::memcpy(out, pos, len);
+            pos += len;
+        }
+
+        template <typename T>
+        T read() {
+            T value;
+            read(&value, sizeof(T));
+            return value;
+        }
+
+        uint32_t read_varuint32() {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                uint8_t byte = read<uint8_t>();
+                value |= uint32_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            throw std::runtime_error("Malformed varuint32");
+        }
+
+        std::string_view read_bytes() {
+            uint32_t len = read_varuint32();
+            if (remaining() < len) throw std::runtime_error("Unexpected end of binary data");
+            std::string_view out(pos, len);
+            pos += len;
+            return out;
+        }
+
+        void skip(size_t len) {
+            if (remaining() < len) throw std::runtime_error("Unexpected end of binary data");
+            pos += len;
+        }
+    };
+
+    // Minimal Antelope binary writer, the inverse of Reader
+    struct Writer {
+        std::string data;
+
+        template <typename T>
+        void write(const T& value) {
+            data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void write_varuint32(uint32_t value) {
+            do {
+                uint8_t byte = value & 0x7f;
+                value >>= 7;
+                if (value) byte |= 0x80;
+                write(byte);
+            } while (value);
+        }
+
+        void write_bytes(std::string_view bytes) {
+            write_varuint32(uint32_t(bytes.size()));
+            data.append(bytes);
+        }
+
+        void write_asset(const Asset& asset) {
+            write(asset.amount);
+            write(asset.symbol_raw());
+        }
+    };
+
+    inline std::string to_hex(std::string_view bytes) {
+        static const char digits[] = "0123456789abcdef";
+        std::string out;
+        out.reserve(bytes.size() * 2);
+        for (unsigned char c : bytes) {
+            out.push_back(digits[c >> 4]);
+            out.push_back(digits[c & 0x0f]);
+        }
+        return out;
+    }
+
+    inline std::string from_hex(std::string_view hex) {
+        auto nibble = [&](char c) -> int {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            throw std::runtime_error("Invalid hex data");
+        };
+        if (hex.size() % 2) throw std::runtime_error("Invalid hex data: odd length");
+        std::string out(hex.size() / 2, '\0');
+        for (size_t i = 0; i < out.size(); ++i) out[i] = char(nibble(hex[2 * i]) << 4 | nibble(hex[2 * i + 1]));
+        return out;
+    }
+
+    // Trailing binary_extension fields (if any) are ignored
+    inline PairingRow unpack_pairing(std::string_view data) {
+        Reader r{data.data(), data.data() + data.size()};
+        PairingRow row;
+        row.synth_ticker = r.read<uint64_t>();
+        row.base_ticker = r.read<uint64_t>();
+        int64_t amount = r.read<int64_t>();
+        row.base_locked = Asset::from_binary(amount, r.read<uint64_t>());
+        return row;
+    }
+
+    inline UnclaimedRow unpack_unclaimed(std::string_view data) {
+        Reader r{data.data(), data.data() + data.size()};
+        UnclaimedRow row;
+        row.base_ticker = r.read<uint64_t>();
+        int64_t amount = r.read<int64_t>();
+        row.total = Asset::from_binary(amount, r.read<uint64_t>());
+        return row;
+    }
+
+    inline BalanceRow unpack_balance(std::string_view data) {
+        Reader r{data.data(), data.data() + data.size()};
+        int64_t amount = r.read<int64_t>();
+        return BalanceRow{Asset::from_binary(amount, r.read<uint64_t>())};
+    }
+
+    // mirror::ExportPage, the return value of the read-only `export` action
+    struct ExportPage {
+        std::vector<PairingRow> pairings;
+        std::vector<Asset> locked_per_base;
+        uint64_t next_cursor = 0;
+        bool more = false;
+    };
+
+    // mirror::EXPORT_RECORD_SIZE, the packed size of a Pairing without its extensions
+    constexpr size_t EXPORT_RECORD_SIZE = 32;
+
+    inline ExportPage unpack_export_page(std::string_view data) {
+        Reader r{data.data(), data.data() + data.size()};
+        ExportPage page;
+        std::string_view records = r.read_bytes();
+        if (records.size() % EXPORT_RECORD_SIZE) throw std::runtime_error("Export records are not a whole number of pairings");
+        page.pairings.reserve(records.size() / EXPORT_RECORD_SIZE);
+        for (size_t offset = 0; offset < records.size(); offset += EXPORT_RECORD_SIZE) {
+            page.pairings.push_back(unpack_pairing(records.substr(offset, EXPORT_RECORD_SIZE)));
+        }
+        uint32_t bases = r.read_varuint32();
+        for (uint32_t i = 0; i < bases; ++i) {
+            int64_t amount = r.read<int64_t>();
+            page.locked_per_base.push_back(Asset::from_binary(amount, r.read<uint64_t>()));
+        }
+        page.next_cursor = r.read<uint64_t>();
+        page.more = r.read<uint8_t>() != 0;
+        return page;
+    }
+
+    /* ---------------- SNAPSHOT FILES ---------------- */
+
+    // Read-only memory mapping of a whole file
+    class MappedFile {
+       public:
+        explicit MappedFile(const std::string& path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("Cannot open " + path);
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat " + path);
+            }
+            size_ = size_t(st.st_size);
+            if (size_ > 0) {
+                void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("Cannot mmap " + path);
+                }
+                data_ = static_cast<const char*>(mapped);
+                ::madvise(mapped, size_, MADV_SEQUENTIAL);
+            }
+            ::close(fd);
+        }
+        ~MappedFile() {
+            if (data_) ::munmap(const_cast<char*>(data_), size_);
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::string_view view() const { return {data_ ? data_ : "", size_}; }
+
+       private:
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    // A snapshot file is either:
+    //  - JSON: one or more `get_table_rows` responses (or bare row arrays), e.g. the output
+    //    of `cleos get table ...`, possibly several pages concatenated
+    //  - Binary: a sequence of `varuint32 length | packed row` records, which is what
+    //    `get_table_rows` returns per row with `json: false` once hex-decoded
+    inline bool is_json_snapshot(std::string_view data) {
+        for (char c : data) {
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+            return c == '{' || c == '[';
+        }
+        return false;
+    }
+
+    // Splits a binary snapshot into its packed rows
+    inline std::vector<std::string_view> split_binary_rows(std::string_view data) {
+        std::vector<std::string_view> rows;
+        Reader r{data.data(), data.data() + data.size()};
+        while (r.remaining()) rows.push_back(r.read_bytes());
+        return rows;
+    }
+
+    // `str` as the body of a JSON string: quotes, backslashes and control characters escaped
+    inline std::string json_escape(std::string_view str) {
+        std::string out;
+        out.reserve(str.size());
+        for (char c : str) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char code[7];
+                std::snprintf(code, sizeof(code), "\\u%04x", c);
+                out += code;
+            } else {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+    // Index of the quote closing the JSON string that opens at `open`
+    inline size_t json_string_end(std::string_view data, size_t open) {
+        for (size_t pos = open + 1; pos < data.size(); ++pos) {
+            if (data[pos] == '\\') ++pos;
+            else if (data[pos] == '"') return pos;
+        }
+        throw std::runtime_error("Unterminated JSON string");
+    }
+
+    // Splits a JSON snapshot into its rows: the objects that are elements of a top-level array
+    // or of a `rows` array, whatever envelope (`{"rows": [...], "more": ...}`) surrounds them.
+    // Nested objects (a pairing's `stats`) stay inside their row.
+    inline std::vector<std::string_view> split_json_rows(std::string_view data) {
+        struct Frame {
+            char type;
+            // Arrays: elements are rows. Objects: this object is a row, opened at `start`.
+            bool rows;
+            size_t start;
+        };
+        std::vector<Frame> stack;
+        std::vector<std::string_view> rows;
+        std::string_view last_string, key;
+
+        for (size_t pos = 0; pos < data.size(); ++pos) {
+            switch (data[pos]) {
+                case '"': {
+                    size_t close = json_string_end(data, pos);
+                    last_string = data.substr(pos + 1, close - pos - 1);
+                    pos = close;
+                    break;
+                }
+                case ':':
+                    key = last_string;
+                    break;
+                case '{': {
+                    bool row = !stack.empty() && stack.back().type == '[' && stack.back().rows;
+                    stack.push_back(Frame{'{', row, pos});
+                    break;
+                }
+                case '[': {
+                    bool row_array = stack.empty() || (stack.back().type == '{' && key == "rows");
+                    stack.push_back(Frame{'[', row_array, pos});
+                    break;
+                }
+                case '}':
+                case ']': {
+                    if (stack.empty() || (stack.back().type == '{') != (data[pos] == '}')) {
+                        throw std::runtime_error("Malformed JSON snapshot");
+                    }
+                    Frame frame = stack.back();
+                    stack.pop_back();
+                    if (frame.type == '{' && frame.rows) rows.push_back(data.substr(frame.start, pos - frame.start + 1));
+                    break;
+                }
+                case ',':
+                    key = {};
+                    break;
+            }
+        }
+        if (!stack.empty()) throw std::runtime_error("Malformed JSON snapshot: unbalanced brackets");
+        return rows;
+    }
+
+    // Extracts the string value of a top-level `"key": "value"` in a row object.
+    // Keys of nested objects are not matched.
+    inline std::optional<std::string_view> json_string_field(std::string_view object, std::string_view key) {
+        int depth = 0;
+        std::string_view last_string;
+        bool value_next = false;
+        for (size_t pos = 0; pos < object.size(); ++pos) {
+            char c = object[pos];
+            if (c == '"') {
+                size_t close = json_string_end(object, pos);
+                std::string_view str = object.substr(pos + 1, close - pos - 1);
+                if (value_next) return str;
+                last_string = str;
+                pos = close;
+            } else if (c == ':') {
+                value_next = depth == 1 && last_string == key;
+                if (value_next) {
+                    // The value is the next token; only strings are returned
+                    size_t next = object.find_first_not_of(" \t\r\n", pos + 1);
+                    if (next == std::string_view::npos || object[next] != '"') return std::nullopt;
+                }
+            } else if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                depth--;
+            } else if (c == ',') {
+                last_string = {};
+            }
+        }
+        return std::nullopt;
+    }
+
+    inline std::optional<PairingRow> parse_pairing_json(std::string_view object) {
+        auto synth = json_string_field(object, "synth_ticker");
+        auto base = json_string_field(object, "base_ticker");
+        auto locked = json_string_field(object, "base_locked");
+        if (!synth || !base || !locked) return std::nullopt;
+        return PairingRow{symbol_code_from_string(*synth), symbol_code_from_string(*base), parse_asset(*locked)};
+    }
+
+    inline std::optional<UnclaimedRow> parse_unclaimed_json(std::string_view object) {
+        auto base = json_string_field(object, "base_ticker");
+        auto total = json_string_field(object, "total");
+        if (!base || !total) return std::nullopt;
+        return UnclaimedRow{symbol_code_from_string(*base), parse_asset(*total)};
+    }
+
+    inline std::optional<BalanceRow> parse_balance_json(std::string_view object) {
+        auto balance = json_string_field(object, "balance");
+        if (!balance) return std::nullopt;
+        return BalanceRow{parse_asset(*balance)};
+    }
+
+}  // namespace mirror_tools
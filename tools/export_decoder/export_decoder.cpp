@@ -0,0 +1,166 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../common/mirror_rows.hpp"
+using namespace mirror_tools;
+
+/*
+ * Mirror Export Decoder
+ * ----------------
+ * Decodes the pages returned by the mirror's read-only `export(cursor, limit)` action, so a
+ * state service can cold-start from a few calls instead of paging `get_table_rows` as JSON.
+ *
+ * Input has one page per line: either the hex return value (`return_value_hex_data` of the
+ * action trace) or a JSON line carrying that field, e.g. the `cleos push action --read-only -j`
+ * output. Pages must be in cursor order, the first one requested with cursor 0.
+ *
+ * The decoder checks that the pages chain (ascending keys, each page starting at the previous
+ * `next_cursor`, the last one without `more`) and that every page's `locked_per_base` matches
+ * its records, then prints the per-base totals. `--out` writes the pairings as a binary
+ * snapshot (`varuint32 length | packed row`) that `tools/auditor --pairings` reads.
+ *
+ * usage: export_decoder [--input <file>] [--out <pairings.bin>] [--rows]
+ * ----------------
+ */
+
+struct BaseTotal {
+    int64_t locked = 0;
+    uint8_t precision = 0;
+    uint64_t pairings = 0;
+};
+
+static std::string page_hex(std::string line) {
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+    if (line.find('{') != std::string::npos) {
+        // Nested inside the action trace, so search for the key itself rather than a top-level field
+        size_t key = line.find("\"return_value_hex_data\"");
+        size_t open = key == std::string::npos ? key : line.find('"', line.find(':', key) + 1);
+        if (open == std::string::npos) throw std::runtime_error("No return_value_hex_data in JSON line");
+        return line.substr(open + 1, json_string_end(line, open) - open - 1);
+    }
+    size_t begin = line.find_first_not_of(" \t\"");
+    size_t end = line.find_last_not_of(" \t\"");
+    return begin == std::string::npos ? "" : line.substr(begin, end - begin + 1);
+}
+
+static int usage() {
+    std::fprintf(stderr, "usage: export_decoder [--input <file>] [--out <pairings.bin>] [--rows]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string input_path, out_path;
+    bool print_rows = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--rows") print_rows = true;
+        else if (i + 1 >= argc) return usage();
+        else if (arg == "--input") input_path = argv[++i];
+        else if (arg == "--out") out_path = argv[++i];
+        else return usage();
+    }
+
+    try {
+        std::ifstream file;
+        if (!input_path.empty()) {
+            file.open(input_path);
+            if (!file) throw std::runtime_error("Cannot open " + input_path);
+        }
+        std::istream& in = input_path.empty() ? std::cin : file;
+
+        std::ofstream out;
+        if (!out_path.empty()) {
+            out.open(out_path, std::ios::binary);
+            if (!out) throw std::runtime_error("Cannot write " + out_path);
+        }
+
+        std::vector<std::string> violations;
+        std::map<std::string, BaseTotal> bases;
+        size_t pages = 0, pairings = 0;
+        uint64_t expected_cursor = 0, last_key = 0;
+        bool more = true;
+
+        std::string line;
+        while (std::getline(in, line)) {
+            std::string hex = page_hex(line);
+            if (hex.empty()) continue;
+            ExportPage page = unpack_export_page(from_hex(hex));
+            std::string label = "page " + std::to_string(++pages);
+
+            if (!more) {
+                violations.push_back(label + ": follows a page without `more`");
+            } else if (pages > 1 && (page.pairings.empty() || page.pairings.front().synth_ticker != expected_cursor)) {
+                // Pairings are never erased, so the row at next_cursor always opens the next page;
+                // any other start means the page was requested from the wrong cursor
+                violations.push_back(label + ": does not start at the previous page's next_cursor " +
+                                     symbol_code_to_string(expected_cursor));
+            }
+
+            std::map<uint64_t, int64_t> page_locked;
+            for (auto& row : page.pairings) {
+                if (pairings > 0 && row.synth_ticker <= last_key) {
+                    violations.push_back(label + ": " + symbol_code_to_string(row.synth_ticker) + " out of order");
+                }
+                last_key = row.synth_ticker;
+                pairings++;
+                page_locked[row.base_locked.code] += row.base_locked.amount;
+
+                auto& total = bases[symbol_code_to_string(row.base_ticker)];
+                total.locked += row.base_locked.amount;
+                total.precision = row.base_locked.precision;
+                total.pairings++;
+
+                if (print_rows) {
+                    std::printf("%-8s %-8s %24s\n", symbol_code_to_string(row.synth_ticker).c_str(),
+                                symbol_code_to_string(row.base_ticker).c_str(), format_asset(row.base_locked).c_str());
+                }
+                if (out) {
+                    Writer w;
+                    w.write(row.synth_ticker);
+                    w.write(row.base_ticker);
+                    w.write_asset(row.base_locked);
+                    Writer record;
+                    record.write_bytes(w.data);
+                    out.write(record.data.data(), std::streamsize(record.data.size()));
+                }
+            }
+
+            for (auto& locked : page.locked_per_base) {
+                auto found = page_locked.find(locked.code);
+                int64_t expected = found == page_locked.end() ? 0 : found->second;
+                if (locked.amount != expected) {
+                    violations.push_back(label + ": " + symbol_code_to_string(locked.code) + " total " +
+                                         format_asset(locked) + " does not match its records");
+                }
+                if (found != page_locked.end()) page_locked.erase(found);
+            }
+            for (auto& [code, amount] : page_locked) {
+                violations.push_back(label + ": no total for base " + symbol_code_to_string(code));
+            }
+
+            more = page.more;
+            expected_cursor = page.next_cursor;
+        }
+        if (pages == 0) throw std::runtime_error("No pages in input");
+        if (more) {
+            violations.push_back("incomplete export: continue from cursor " + std::to_string(expected_cursor));
+        }
+
+        std::printf("%-8s %9s %24s\n", "base", "pairings", "locked");
+        for (auto& [ticker, total] : bases) {
+            std::printf("%-8s %9llu %24s\n", ticker.c_str(), (unsigned long long)total.pairings,
+                        format_amount(total.locked, total.precision).c_str());
+        }
+        std::printf("\n%zu pairings across %zu bases from %zu pages, %zu violations\n", pairings, bases.size(), pages,
+                    violations.size());
+        for (auto& v : violations) std::printf("  ! %s\n", v.c_str());
+        return violations.empty() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "export_decoder: %s\n", e.what());
+        return 2;
+    }
+}
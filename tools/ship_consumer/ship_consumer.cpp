@@ -0,0 +1,670 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../common/mirror_rows.hpp"
+using namespace mirror_tools;
+
+/*
+ * Mirror State-History Consumer
+ * ----------------
+ * Follows state-history table deltas and keeps the mirror's live state in memory:
+ *   - `pairings` rows of the mirror account (code = scope = mirror)
+ *   - `unclaimed` rows of the mirror account: non-creator deposits recorded per base
+ *   - the mirror account's balances in the totems `accounts` table (code = totems, scope = mirror)
+ * indexed by synth ticker and by base ticker, and answers queries over a local socket so
+ * API servers never have to call `get_table_rows`.
+ *
+ * Input is either:
+ *   - `ws://host:port`: the node's state_history_plugin endpoint. The consumer speaks the
+ *     protocol itself: it reads the node's ABI, sends `get_status_request_v0`, then
+ *     `get_blocks_request_v0` with only `fetch_deltas` set and acks every
+ *     `--max-in-flight` results. It follows irreversible blocks only, so forks never have
+ *     to be undone, and reconnects from the next block when the connection drops.
+ *     Start at a block whose deltas hold the full table state: by default the first block
+ *     the node has state history for (`chain_state_begin_block`), or pass `--start-block`.
+ *   - a stream of recorded frames, each `uint32 length (LE) | vector<table_delta>` where the
+ *     payload is exactly the `deltas` field of a `get_blocks_result`, from a file (offline
+ *     replay / tests) or a unix socket.
+ *
+ * Query protocol (one request per line, one JSON response per line):
+ *   synth <TICKER>   -> the pairing for that synth
+ *   base <TICKER>    -> every pairing backed by that base, plus locked/unclaimed/balance/untracked
+ *                       totals, where untracked = balance - locked - unclaimed (creator deposits
+ *                       the next `mint` will pick up)
+ *   status           -> row counts, delta payloads applied and the last block applied
+ *
+ * Without `--listen` the input is read to its end (`--end-block`, exclusive, for a node),
+ * then every `--query` is answered on stdout.
+ *
+ * usage: ship_consumer --input <ws://host:port|file|unix:/path> [--mirror <account>] [--totems <account>]
+ *                      [--start-block N] [--end-block N] [--max-in-flight N]
+ *                      [--listen /path/to.sock] [--query "<request>"]...
+ * ----------------
+ */
+
+/* ---------------- STATE ---------------- */
+
+class MirrorState {
+   public:
+    void upsert_pairing(const PairingRow& row) {
+        auto existing = pairings_.find(row.synth_ticker);
+        if (existing != pairings_.end() && existing->second.base_ticker != row.base_ticker) {
+            by_base_[existing->second.base_ticker].erase(row.synth_ticker);
+        }
+        pairings_[row.synth_ticker] = row;
+        by_base_[row.base_ticker].insert(row.synth_ticker);
+    }
+
+    void erase_pairing(uint64_t synth) {
+        auto existing = pairings_.find(synth);
+        if (existing == pairings_.end()) return;
+        auto base = by_base_.find(existing->second.base_ticker);
+        base->second.erase(synth);
+        if (base->second.empty()) by_base_.erase(base);
+        pairings_.erase(existing);
+    }
+
+    void upsert_unclaimed(const UnclaimedRow& row) { unclaimed_[row.base_ticker] = row.total.amount; }
+    void erase_unclaimed(uint64_t base) { unclaimed_.erase(base); }
+
+    void upsert_balance(const Asset& balance) { balances_[balance.code] = balance; }
+    void erase_balance(uint64_t code) { balances_.erase(code); }
+
+    std::string query(const std::string& request) const {
+        auto space = request.find(' ');
+        std::string command = request.substr(0, space);
+        std::string arg = space == std::string::npos ? "" : request.substr(space + 1);
+
+        if (command == "status") {
+            return "{\"pairings\":" + std::to_string(pairings_.size()) + ",\"bases\":" + std::to_string(by_base_.size()) +
+                   ",\"balances\":" + std::to_string(balances_.size()) +
+                   ",\"unclaimed\":" + std::to_string(unclaimed_.size()) + ",\"frames\":" + std::to_string(frames) +
+                   ",\"block\":" + std::to_string(block) + "}";
+        }
+        if (command == "synth") {
+            auto it = pairings_.find(symbol_code_from_string(arg));
+            if (it == pairings_.end()) return error("Pairing not found: " + arg);
+            return pairing_json(it->second);
+        }
+        if (command == "base") {
+            uint64_t base = symbol_code_from_string(arg);
+            auto synths = by_base_.find(base);
+            if (synths == by_base_.end()) return error("No pairings for base: " + arg);
+
+            std::string rows;
+            int64_t locked = 0;
+            uint8_t precision = 0;
+            for (uint64_t synth : synths->second) {
+                const PairingRow& row = pairings_.at(synth);
+                if (!rows.empty()) rows += ",";
+                rows += pairing_json(row);
+                locked += row.base_locked.amount;
+                precision = row.base_locked.precision;
+            }
+            auto balance = balances_.find(base);
+            int64_t held = balance == balances_.end() ? 0 : balance->second.amount;
+            auto recorded = unclaimed_.find(base);
+            int64_t unclaimed = recorded == unclaimed_.end() ? 0 : recorded->second;
+            return "{\"base_ticker\":\"" + symbol_code_to_string(base) + "\",\"pairings\":[" + rows + "],\"locked\":\"" +
+                   format_asset(Asset{locked, precision, base}) + "\",\"unclaimed\":\"" +
+                   format_asset(Asset{unclaimed, precision, base}) + "\",\"balance\":\"" +
+                   format_asset(Asset{held, precision, base}) + "\",\"untracked\":\"" +
+                   format_asset(Asset{held - locked - unclaimed, precision, base}) + "\"}";
+        }
+        return error("Unknown query");
+    }
+
+    // Messages can carry raw client input, so they are always escaped
+    static std::string error(const std::string& message) { return "{\"error\":\"" + json_escape(message) + "\"}"; }
+
+    uint64_t frames = 0;
+    // Last block applied from a state history node (0 for recorded frames)
+    uint32_t block = 0;
+
+   private:
+    static std::string pairing_json(const PairingRow& row) {
+        return "{\"synth_ticker\":\"" + symbol_code_to_string(row.synth_ticker) + "\",\"base_ticker\":\"" +
+               symbol_code_to_string(row.base_ticker) + "\",\"base_locked\":\"" + format_asset(row.base_locked) + "\"}";
+    }
+
+    std::unordered_map<uint64_t, PairingRow> pairings_;
+    // std::set keeps a base's synths in ticker order for stable responses
+    std::unordered_map<uint64_t, std::set<uint64_t>> by_base_;
+    // Amount recorded in the deposit ledger per base
+    std::unordered_map<uint64_t, int64_t> unclaimed_;
+    std::unordered_map<uint64_t, Asset> balances_;
+};
+
+/* ---------------- DELTAS ---------------- */
+
+struct Filter {
+    uint64_t mirror = name_from_string("mirrormirror");
+    uint64_t totems = name_from_string("totemstotems");
+    uint64_t pairings_table = name_from_string("pairings");
+    uint64_t unclaimed_table = name_from_string("unclaimed");
+    uint64_t accounts_table = name_from_string("accounts");
+};
+
+// Applies one `vector<table_delta>` payload. Only `contract_row` deltas for the
+// tables we track are decoded; everything else is skipped by length.
+static void apply_deltas(std::string_view payload, const Filter& filter, MirrorState& state) {
+    Reader r{payload.data(), payload.data() + payload.size()};
+    uint32_t delta_count = r.read_varuint32();
+    for (uint32_t d = 0; d < delta_count; ++d) {
+        // table_delta_v0 and table_delta_v1 share { string name; vector<row> rows; }
+        uint32_t variant = r.read_varuint32();
+        if (variant > 1) throw std::runtime_error("Unsupported table_delta variant");
+        std::string_view table_name = r.read_bytes();
+        bool contract_rows = table_name == "contract_row";
+
+        uint32_t row_count = r.read_varuint32();
+        for (uint32_t i = 0; i < row_count; ++i) {
+            bool present = r.read<uint8_t>() != 0;
+            std::string_view data = r.read_bytes();
+            if (!contract_rows) continue;
+
+            // contract_row_v0 { name code; name scope; name table; uint64 primary_key; name payer; bytes value; }
+            Reader row{data.data(), data.data() + data.size()};
+            if (row.read_varuint32() != 0) throw std::runtime_error("Unsupported contract_row variant");
+            uint64_t code = row.read<uint64_t>();
+            uint64_t scope = row.read<uint64_t>();
+            uint64_t table = row.read<uint64_t>();
+            uint64_t primary_key = row.read<uint64_t>();
+            row.skip(sizeof(uint64_t));  // payer
+            std::string_view value = row.read_bytes();
+
+            if (scope != filter.mirror) continue;
+            if (code == filter.mirror && table == filter.pairings_table) {
+                if (present) state.upsert_pairing(unpack_pairing(value));
+                else state.erase_pairing(primary_key);
+            } else if (code == filter.mirror && table == filter.unclaimed_table) {
+                if (present) state.upsert_unclaimed(unpack_unclaimed(value));
+                else state.erase_unclaimed(primary_key);
+            } else if (code == filter.totems && table == filter.accounts_table) {
+                if (present) state.upsert_balance(unpack_balance(value).balance);
+                else state.erase_balance(primary_key);
+            }
+        }
+    }
+    state.frames++;
+}
+
+/* ---------------- IO ---------------- */
+
+static bool read_exact(int fd, char* out, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::read(fd, out, len);
+        if (n == 0) return false;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Read failed");
+        }
+        out += n;
+        len -= size_t(n);
+    }
+    return true;
+}
+
+static bool write_all(int fd, std::string_view data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::write(fd, data.data() + sent, data.size() - sent);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        sent += size_t(n);
+    }
+    return true;
+}
+
+static sockaddr_un unix_address(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) throw std::runtime_error("Socket path too long: " + path);
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+static int open_input(const std::string& input) {
+    if (input.rfind("unix:", 0) == 0) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        auto addr = unix_address(input.substr(5));
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            throw std::runtime_error("Cannot connect to " + input);
+        }
+        return fd;
+    }
+    int fd = ::open(input.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open " + input);
+    return fd;
+}
+
+// Reads frames until the input closes
+static void ingest(int fd, const Filter& filter, MirrorState& state, std::shared_mutex& lock) {
+    std::vector<char> buffer;
+    uint32_t len;
+    while (read_exact(fd, reinterpret_cast<char*>(&len), sizeof(len))) {
+        buffer.resize(len);
+        if (!read_exact(fd, buffer.data(), len)) throw std::runtime_error("Truncated frame");
+        std::unique_lock guard(lock);
+        apply_deltas({buffer.data(), len}, filter, state);
+    }
+}
+
+// One JSON response line for a request, errors included
+static std::string respond(const MirrorState& state, std::shared_mutex& lock, const std::string& request) {
+    try {
+        std::shared_lock guard(lock);
+        return state.query(request);
+    } catch (const std::exception& e) {
+        return MirrorState::error(e.what());
+    }
+}
+
+/* ---------------- STATE HISTORY ---------------- */
+
+// ws://host:port[/path]
+struct Endpoint {
+    std::string host;
+    std::string port;
+    std::string path = "/";
+};
+
+static Endpoint parse_ws_url(const std::string& url) {
+    std::string rest = url.substr(5);
+    Endpoint endpoint;
+    auto slash = rest.find('/');
+    if (slash != std::string::npos) endpoint.path = rest.substr(slash);
+    std::string authority = rest.substr(0, slash);
+    auto colon = authority.rfind(':');
+    if (colon == std::string::npos || colon + 1 == authority.size()) {
+        throw std::runtime_error("State history URL needs a port: " + url);
+    }
+    endpoint.host = authority.substr(0, colon);
+    endpoint.port = authority.substr(colon + 1);
+    return endpoint;
+}
+
+static std::string base64(std::string_view bytes) {
+    static const char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        uint32_t chunk = uint32_t(uint8_t(bytes[i])) << 16;
+        if (i + 1 < bytes.size()) chunk |= uint32_t(uint8_t(bytes[i + 1])) << 8;
+        if (i + 2 < bytes.size()) chunk |= uint8_t(bytes[i + 2]);
+        out += digits[chunk >> 18 & 63];
+        out += digits[chunk >> 12 & 63];
+        out += i + 1 < bytes.size() ? digits[chunk >> 6 & 63] : '=';
+        out += i + 2 < bytes.size() ? digits[chunk & 63] : '=';
+    }
+    return out;
+}
+
+// Minimal RFC 6455 client, as much as the state history plugin needs: one connection,
+// binary messages, no extensions. Client frames are masked, server frames must not be.
+class WebSocket {
+   public:
+    explicit WebSocket(const Endpoint& endpoint) {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* found = nullptr;
+        if (::getaddrinfo(endpoint.host.c_str(), endpoint.port.c_str(), &hints, &found) != 0) {
+            throw std::runtime_error("Cannot resolve " + endpoint.host);
+        }
+        for (addrinfo* addr = found; addr && fd_ < 0; addr = addr->ai_next) {
+            fd_ = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+            if (fd_ >= 0 && ::connect(fd_, addr->ai_addr, addr->ai_addrlen) != 0) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+        ::freeaddrinfo(found);
+        if (fd_ < 0) throw std::runtime_error("Cannot connect to " + endpoint.host + ":" + endpoint.port);
+        handshake(endpoint);
+    }
+
+    ~WebSocket() { ::close(fd_); }
+    WebSocket(const WebSocket&) = delete;
+    WebSocket& operator=(const WebSocket&) = delete;
+
+    // Next complete data message; false once the server closes the connection
+    bool receive(std::string& message) {
+        message.clear();
+        for (;;) {
+            uint8_t header[2];
+            if (!read_exact(fd_, reinterpret_cast<char*>(header), sizeof(header))) return false;
+            bool fin = header[0] & 0x80;
+            uint8_t opcode = header[0] & 0x0f;
+            if (header[1] & 0x80) throw std::runtime_error("Server WebSocket frames must not be masked");
+
+            uint64_t len = header[1] & 0x7f;
+            if (len >= 126) {
+                uint8_t extended[8];
+                size_t size = len == 126 ? 2 : 8;
+                if (!read_exact(fd_, reinterpret_cast<char*>(extended), size)) throw std::runtime_error("Truncated WebSocket frame");
+                len = 0;
+                for (size_t i = 0; i < size; ++i) len = len << 8 | extended[i];
+            }
+            if (len > MAX_MESSAGE) throw std::runtime_error("WebSocket message too large");
+
+            std::string payload(len, '\0');
+            if (!read_exact(fd_, payload.data(), len)) throw std::runtime_error("Truncated WebSocket frame");
+            switch (opcode) {
+                case 0x8:  // close
+                    return false;
+                case 0x9:  // ping
+                    send_frame(0xa, payload);
+                    continue;
+                case 0xa:  // pong
+                    continue;
+                case 0x0:  // continuation
+                case 0x1:  // text
+                case 0x2:  // binary
+                    message += payload;
+                    if (message.size() > MAX_MESSAGE) throw std::runtime_error("WebSocket message too large");
+                    if (fin) return true;
+                    continue;
+                default:
+                    throw std::runtime_error("Unsupported WebSocket opcode " + std::to_string(opcode));
+            }
+        }
+    }
+
+    void send(std::string_view message) { send_frame(0x2, message); }
+
+   private:
+    // A block's deltas can be large, but not this large
+    static constexpr uint64_t MAX_MESSAGE = 1ull << 30;
+
+    void handshake(const Endpoint& endpoint) {
+        std::string key(16, '\0');
+        for (auto& c : key) c = char(random_());
+        std::string request = "GET " + endpoint.path + " HTTP/1.1\r\nHost: " + endpoint.host + ":" + endpoint.port +
+                              "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: " + base64(key) +
+                              "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+        if (!write_all(fd_, request)) throw std::runtime_error("WebSocket handshake failed");
+
+        std::string response;
+        while (response.size() < 4 || response.compare(response.size() - 4, 4, "\r\n\r\n") != 0) {
+            char c;
+            if (!read_exact(fd_, &c, 1)) throw std::runtime_error("Connection closed during WebSocket handshake");
+            response += c;
+            if (response.size() > 16384) throw std::runtime_error("WebSocket handshake response too large");
+        }
+        if (response.rfind("HTTP/1.1 101", 0) != 0) {
+            throw std::runtime_error("WebSocket upgrade refused: " + response.substr(0, response.find('\r')));
+        }
+    }
+
+    void send_frame(uint8_t opcode, std::string_view payload) {
+        std::string frame(1, char(0x80 | opcode));
+        if (payload.size() < 126) {
+            frame += char(0x80 | payload.size());
+        } else if (payload.size() <= 0xffff) {
+            frame += char(0x80 | 126);
+            for (int shift = 8; shift >= 0; shift -= 8) frame += char(payload.size() >> shift);
+        } else {
+            frame += char(0x80 | 127);
+            for (int shift = 56; shift >= 0; shift -= 8) frame += char(uint64_t(payload.size()) >> shift);
+        }
+        char mask[4];
+        for (auto& c : mask) c = char(random_());
+        frame.append(mask, sizeof(mask));
+        for (size_t i = 0; i < payload.size(); ++i) frame += char(payload[i] ^ mask[i % 4]);
+        if (!write_all(fd_, frame)) throw std::runtime_error("WebSocket write failed");
+    }
+
+    int fd_ = -1;
+    std::independent_bits_engine<std::mt19937, 8, uint32_t> random_{std::random_device{}()};
+};
+
+// state_history_plugin `request` and `result` variant indexes, from the ABI the node sends
+enum : uint32_t { GET_STATUS_REQUEST_V0 = 0, GET_BLOCKS_REQUEST_V0 = 1, GET_BLOCKS_ACK_REQUEST_V0 = 2 };
+enum : uint32_t { GET_STATUS_RESULT_V0 = 0, GET_BLOCKS_RESULT_V0 = 1 };
+
+struct ShipOptions {
+    uint32_t start_block = 0;  // 0: the first block the node has state history for
+    uint32_t end_block = 0xffffffff;
+    uint32_t max_in_flight = 16;
+};
+
+// block_position { uint32 block_num; checksum256 block_id; }
+static uint32_t read_block_position(Reader& r) {
+    uint32_t block_num = r.read<uint32_t>();
+    r.skip(32);
+    return block_num;
+}
+
+// Streams deltas from `next_block` until `end_block` or the node closes the connection.
+// `next_block` advances as blocks are applied, so a caller can reconnect and resume.
+static bool follow_ship(const Endpoint& endpoint, const ShipOptions& options, uint32_t& next_block, const Filter& filter,
+                        MirrorState& state, std::shared_mutex& lock) {
+    WebSocket ws(endpoint);
+    std::string message;
+    // The first message is the protocol ABI as JSON; the layouts below are fixed by it
+    if (!ws.receive(message)) throw std::runtime_error("State history closed before sending its ABI");
+
+    Writer status;
+    status.write_varuint32(GET_STATUS_REQUEST_V0);
+    ws.send(status.data);
+    if (!ws.receive(message)) throw std::runtime_error("State history closed before sending its status");
+    {
+        // get_status_result_v0 { head; last_irreversible; trace_begin_block; trace_end_block;
+        //                        chain_state_begin_block; chain_state_end_block; }
+        Reader r{message.data(), message.data() + message.size()};
+        if (r.read_varuint32() != GET_STATUS_RESULT_V0) throw std::runtime_error("Expected get_status_result_v0");
+        read_block_position(r);
+        read_block_position(r);
+        r.skip(2 * sizeof(uint32_t));
+        uint32_t chain_state_begin = r.read<uint32_t>();
+        if (next_block == 0) {
+            next_block = chain_state_begin;
+        } else if (next_block < chain_state_begin) {
+            throw std::runtime_error("Node has no state history before block " + std::to_string(chain_state_begin));
+        }
+    }
+    if (next_block >= options.end_block) return true;
+
+    Writer request;
+    request.write_varuint32(GET_BLOCKS_REQUEST_V0);
+    request.write(next_block);
+    request.write(options.end_block);
+    request.write(options.max_in_flight);
+    request.write_varuint32(0);     // have_positions
+    request.write(uint8_t(1));      // irreversible_only
+    request.write(uint8_t(0));      // fetch_block
+    request.write(uint8_t(0));      // fetch_traces
+    request.write(uint8_t(1));      // fetch_deltas
+    ws.send(request.data);
+
+    uint32_t unacked = 0;
+    while (ws.receive(message)) {
+        // get_blocks_result_v0 { head; last_irreversible; optional<block_position> this_block;
+        //                        optional<block_position> prev_block; optional<bytes> block, traces, deltas; }
+        Reader r{message.data(), message.data() + message.size()};
+        if (r.read_varuint32() != GET_BLOCKS_RESULT_V0) throw std::runtime_error("Expected get_blocks_result_v0");
+        read_block_position(r);
+        read_block_position(r);
+        std::optional<uint32_t> this_block;
+        if (r.read<uint8_t>()) this_block = read_block_position(r);
+        if (r.read<uint8_t>()) read_block_position(r);
+        if (r.read<uint8_t>()) r.read_bytes();
+        if (r.read<uint8_t>()) r.read_bytes();
+        std::optional<std::string_view> deltas;
+        if (r.read<uint8_t>()) deltas = r.read_bytes();
+
+        if (this_block) {
+            std::unique_lock guard(lock);
+            if (deltas) apply_deltas(*deltas, filter, state);
+            state.block = *this_block;
+            next_block = *this_block + 1;
+        }
+        if (++unacked == options.max_in_flight) {
+            Writer ack;
+            ack.write_varuint32(GET_BLOCKS_ACK_REQUEST_V0);
+            ack.write(unacked);
+            ws.send(ack.data);
+            unacked = 0;
+        }
+        if (next_block >= options.end_block) return true;
+    }
+    return false;
+}
+
+/* ---------------- QUERIES ---------------- */
+
+static void serve_client(int client, const MirrorState& state, std::shared_mutex& lock) {
+    std::string pending;
+    char chunk[512];
+    ssize_t n;
+    while ((n = ::read(client, chunk, sizeof(chunk))) > 0) {
+        pending.append(chunk, size_t(n));
+        size_t newline;
+        while ((newline = pending.find('\n')) != std::string::npos) {
+            std::string request = pending.substr(0, newline);
+            pending.erase(0, newline + 1);
+            if (!request.empty() && request.back() == '\r') request.pop_back();
+
+            write_all(client, respond(state, lock, request) + "\n");
+        }
+    }
+    ::close(client);
+}
+
+static void listen_forever(const std::string& path, const MirrorState& state, std::shared_mutex& lock) {
+    int server = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    auto addr = unix_address(path);
+    ::unlink(path.c_str());
+    if (server < 0 || ::bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(server, 64) != 0) {
+        throw std::runtime_error("Cannot listen on " + path);
+    }
+    for (;;) {
+        int client = ::accept(server, nullptr, nullptr);
+        if (client < 0) continue;
+        std::thread(serve_client, client, std::cref(state), std::ref(lock)).detach();
+    }
+}
+
+static int usage() {
+    std::fprintf(stderr,
+                 "usage: ship_consumer --input <ws://host:port|file|unix:/path> [--mirror <account>] [--totems <account>]\n"
+                 "                     [--start-block N] [--end-block N] [--max-in-flight N]\n"
+                 "                     [--listen /path/to.sock] [--query \"<request>\"]...\n");
+    return 2;
+}
+
+static uint32_t parse_uint32(const std::string& value) {
+    size_t used = 0;
+    unsigned long parsed = std::stoul(value, &used);
+    if (used != value.size() || parsed > 0xffffffff) throw std::runtime_error("Invalid number: " + value);
+    return uint32_t(parsed);
+}
+
+// Follows the node until `end_block`. With `reconnect` a dropped connection is retried from the
+// next block (serving mode); otherwise it is an error (offline mode must see every block).
+static void follow_node(const Endpoint& endpoint, const ShipOptions& options, bool reconnect, const Filter& filter,
+                        MirrorState& state, std::shared_mutex& lock) {
+    uint32_t next_block = options.start_block;
+    for (;;) {
+        try {
+            if (follow_ship(endpoint, options, next_block, filter, state, lock)) return;
+            if (!reconnect) throw std::runtime_error("State history closed at block " + std::to_string(next_block));
+        } catch (const std::exception& e) {
+            if (!reconnect) throw;
+            std::fprintf(stderr, "ship_consumer: %s, reconnecting from block %u\n", e.what(), next_block);
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string input, listen_path;
+    std::vector<std::string> queries;
+    Filter filter;
+    ShipOptions ship;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) return usage();
+            if (arg == "--input") input = argv[++i];
+            else if (arg == "--listen") listen_path = argv[++i];
+            else if (arg == "--query") queries.push_back(argv[++i]);
+            else if (arg == "--mirror") filter.mirror = name_from_string(argv[++i]);
+            else if (arg == "--totems") filter.totems = name_from_string(argv[++i]);
+            else if (arg == "--start-block") ship.start_block = parse_uint32(argv[++i]);
+            else if (arg == "--end-block") ship.end_block = parse_uint32(argv[++i]);
+            else if (arg == "--max-in-flight") ship.max_in_flight = parse_uint32(argv[++i]);
+            else return usage();
+        }
+        if (input.empty()) return usage();
+
+        if (ship.max_in_flight == 0) throw std::runtime_error("--max-in-flight must be positive");
+
+        MirrorState state;
+        std::shared_mutex lock;
+
+        if (input.rfind("ws://", 0) == 0) {
+            Endpoint endpoint = parse_ws_url(input);
+            if (listen_path.empty()) {
+                follow_node(endpoint, ship, false, filter, state, lock);
+                for (auto& q : queries) std::printf("%s\n", respond(state, lock, q).c_str());
+                return 0;
+            }
+            std::thread follower([&, endpoint] {
+                try {
+                    follow_node(endpoint, ship, true, filter, state, lock);
+                } catch (const std::exception& e) {
+                    std::fprintf(stderr, "ship_consumer: %s\n", e.what());
+                    std::exit(1);
+                }
+                std::fprintf(stderr, "ship_consumer: reached end block %u\n", ship.end_block);
+            });
+            follower.detach();
+            listen_forever(listen_path, state, lock);
+        }
+
+        int fd = open_input(input);
+
+        if (listen_path.empty()) {
+            // Offline replay: apply everything, answer the queries, exit
+            ingest(fd, filter, state, lock);
+            ::close(fd);
+            for (auto& q : queries) std::printf("%s\n", respond(state, lock, q).c_str());
+            return 0;
+        }
+
+        // Queries are served while deltas keep streaming in
+        std::thread follower([&] {
+            try {
+                ingest(fd, filter, state, lock);
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "ship_consumer: %s\n", e.what());
+                std::exit(1);
+            }
+            ::close(fd);
+        });
+        follower.detach();
+        listen_forever(listen_path, state, lock);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ship_consumer: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,116 @@
+#!/usr/bin/env bash
+# Fixture checks for the off-chain tools in tools/
+#
+# Builds each tool and runs it against tools/tests/fixtures, checking the exit
+# code and the lines it must print.
+#
+# Usage: tools/tests/run.sh
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "$0")/../.." && pwd)"
+FIXTURES="$ROOT/tools/tests/fixtures"
+BIN="$(mktemp -d)"
+trap 'rm -rf "$BIN"' EXIT
+
+g++ -std=c++17 -O2 -pthread -o "$BIN/auditor" "$ROOT/tools/auditor/auditor.cpp"
+g++ -std=c++17 -O2 -o "$BIN/export_decoder" "$ROOT/tools/export_decoder/export_decoder.cpp"
+g++ -std=c++17 -O2 -pthread -o "$BIN/ship_consumer" "$ROOT/tools/ship_consumer/ship_consumer.cpp"
+g++ -std=c++17 -O2 -o "$BIN/tx_packer" "$ROOT/tools/tx_packer/tx_packer.cpp"
+
+FAILED=0
+
+# check <name> <expected exit code> <pattern that must appear in the output> -- <command...>
+check() {
+    local name="$1" code="$2" pattern="$3"
+    shift 4
+    local output status=0
+    output="$("$@" 2>&1)" || status=$?
+    if [[ "$status" != "$code" ]] || ! grep -qE -- "$pattern" <<< "$output"; then
+        echo "FAIL $name (exit $status, expected $code and /$pattern/)"
+        sed 's/^/    /' <<< "$output"
+        FAILED=1
+    else
+        echo "ok   $name"
+    fi
+}
+
+# Rows with a nested `stats` object are pairings too, next to legacy rows without it
+check "auditor counts pairing rows with stats" 0 "^BASE +2 +200.0000 +- +230.0000 +30.0000 +ok" -- \
+    "$BIN/auditor" --pairings "$FIXTURES/pairings_stats.json" --accounts "$FIXTURES/accounts_ok.json"
+check "auditor flags under-reserved base with stats rows" 1 "UNDER_RESERVED" -- \
+    "$BIN/auditor" --pairings "$FIXTURES/pairings_stats.json" --accounts "$FIXTURES/accounts_under.json"
+
+# Recorded non-creator deposits are owed too, so they come out of the untracked rest
+check "auditor subtracts the unclaimed ledger" 0 "^BASE +2 +200.0000 +20.0000 +230.0000 +10.0000 +ok" -- \
+    "$BIN/auditor" --pairings "$FIXTURES/pairings_stats.json" --accounts "$FIXTURES/accounts_ok.json" \
+    --unclaimed "$FIXTURES/unclaimed.json"
+check "auditor flags a balance below locked plus unclaimed" 1 "locked 200.0000 \\+ unclaimed 20.0000 exceeds" -- \
+    "$BIN/auditor" --pairings "$FIXTURES/pairings_stats.json" --accounts "$FIXTURES/accounts_under.json" \
+    --unclaimed "$FIXTURES/unclaimed.json"
+
+# Export pages: hex lines or JSON action traces, chained by next_cursor
+check "export_decoder follows a page chain" 0 "^BASE +3 +175.0000$" -- \
+    "$BIN/export_decoder" --input "$FIXTURES/export_chain.txt" --out "$BIN/exported.bin"
+check "auditor reads the decoder's pairings snapshot" 0 "^BASE +3 +175.0000 +- +230.0000 +55.0000 +ok" -- \
+    "$BIN/auditor" --pairings "$BIN/exported.bin" --accounts "$FIXTURES/accounts_ok.json"
+check "export_decoder flags a page that skips the cursor" 1 "page 2: does not start at the previous page's next_cursor SYNTHC" -- \
+    "$BIN/export_decoder" --input "$FIXTURES/export_skip.txt"
+check "export_decoder flags an incomplete export" 1 "incomplete export" -- \
+    "$BIN/export_decoder" --input "$FIXTURES/export_incomplete.txt"
+
+# Recorded deltas (deltas.bin, three blocks): block 1 holds the full state, SYNTH (with its
+# row_version/stats extensions) and SYNTH2 on BASE, the unclaimed ledger, the mirror's balance,
+# plus rows of other scopes and a non-contract_row table that must be skipped; block 2 updates
+# SYNTH and the balance; block 3 erases SYNTH2
+FRAMES="$FIXTURES/deltas.bin"
+BASE_STATE='^\{"base_ticker":"BASE","pairings":\[\{"synth_ticker":"SYNTH","base_ticker":"BASE","base_locked":"150.0000 BASE"\}\],"locked":"150.0000 BASE","unclaimed":"20.0000 BASE","balance":"260.0000 BASE","untracked":"90.0000 BASE"\}$'
+check "ship_consumer replays recorded frames" 0 "$BASE_STATE" -- \
+    "$BIN/ship_consumer" --input "$FRAMES" --query "base BASE"
+check "ship_consumer applies row removals" 0 '^\{"error":"Pairing not found: SYNTH2"\}$' -- \
+    "$BIN/ship_consumer" --input "$FRAMES" --query "synth SYNTH2"
+
+# The same blocks from a stand-in state history node (tools/tests/ship_server.py), which checks
+# the status/blocks requests and holds back results until they are acked
+ship_node() {
+    rm -f "$BIN/port"
+    python3 "$ROOT/tools/tests/ship_server.py" "$FRAMES" "$BIN/port" >&2 &
+    for _ in $(seq 100); do [[ -s "$BIN/port" ]] && break; sleep 0.05; done
+    NODE="ws://127.0.0.1:$(cat "$BIN/port")"
+}
+node_done() {
+    wait $! || { echo "FAIL stand-in node rejected the consumer's requests"; FAILED=1; }
+}
+ship_node
+check "ship_consumer follows a state history node" 0 '"frames":3,"block":3\}$' -- \
+    "$BIN/ship_consumer" --input "$NODE" --end-block 4 --max-in-flight 1 --query "base BASE" --query status
+node_done
+ship_node
+check "ship_consumer serves the followed state" 0 "$BASE_STATE" -- \
+    "$BIN/ship_consumer" --input "$NODE" --end-block 4 --query "base BASE"
+node_done
+ship_node
+check "ship_consumer fails when the node closes before the end block" 1 "State history closed at block 4" -- \
+    "$BIN/ship_consumer" --input "$NODE" --end-block 10 --query status
+node_done
+
+# Error responses stay valid JSON whatever the client sent
+check "ship_consumer escapes client input in errors" 0 '^\{"error":"Invalid symbol code: \\"x"\}$' -- \
+    "$BIN/ship_consumer" --input /dev/null --query 'synth "x'
+
+# manifest.txt packed against bench_output.txt's p99 costs under a 5000 us budget: two setups
+# and a mint (4100 us with the overhead), two mints (4100 us), then the 50-row migration
+# (3100 us). fixtures/txs holds the expected transactions, which tests/txpacker.spec.ts
+# replays in the VM, so the split and every hex_data are compared byte for byte.
+PACK=(--manifest "$FIXTURES/manifest.txt" --costs "$FIXTURES/bench_output.txt" --cpu-us 5000)
+check "tx_packer splits the manifest at the CPU budget" 0 "6 operations \(9 actions\) packed into 3 transactions" -- \
+    "$BIN/tx_packer" "${PACK[@]}" --out "$BIN/txs" --mirror mirror
+check "tx_packer writes the expected transactions" 0 "" -- \
+    diff -r "$FIXTURES/txs" "$BIN/txs"
+check "tx_packer defaults to the deployed mirror account" 0 "packed into 3 transactions" -- \
+    "$BIN/tx_packer" "${PACK[@]}" --out "$BIN/txs_default"
+check "tx_packer actions name the deployed mirror account" 0 '"account": "mirrormirror", "name": "setup"' -- \
+    cat "$BIN/txs_default/tx_0001.json"
+check "tx_packer refuses a p99 from too few runs" 2 "Bench case setup has runs=20, p99_us needs at least 100" -- \
+    "$BIN/tx_packer" "${PACK[@]:0:2}" --costs "$FIXTURES/bench_few_runs.txt" --out "$BIN/txs_few"
+
+exit "$FAILED"
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""Stand-in state history node for tools/tests/run.sh.
+
+Serves one websocket connection the way the state_history_plugin does: sends its ABI,
+answers get_status_request_v0, then streams every recorded frame of a deltas file
+(`uint32 length | vector<table_delta>`) as one get_blocks_result_v0 each, starting at
+block 1, never sending more than max_messages_in_flight results ahead of the client's
+acks. Checks the client's requests on the way and exits non-zero on anything the real
+plugin would reject or that would lose blocks.
+
+usage: ship_server.py <deltas file> <port file>   (writes the port it listens on)
+"""
+import base64
+import hashlib
+import socket
+import struct
+import sys
+
+GUID = b"258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+
+def fail(message):
+    print(f"ship_server: {message}", file=sys.stderr)
+    sys.exit(1)
+
+
+def recv_exact(conn, size):
+    data = b""
+    while len(data) < size:
+        chunk = conn.recv(size - len(data))
+        if not chunk:
+            fail("client closed the connection")
+        data += chunk
+    return data
+
+
+def varuint(value):
+    out = b""
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out += bytes([byte | 0x80])
+        else:
+            return out + bytes([byte])
+
+
+def read_varuint(data, pos):
+    value = shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def send_message(conn, payload, opcode=0x2):
+    header = bytes([0x80 | opcode])
+    if len(payload) < 126:
+        header += bytes([len(payload)])
+    elif len(payload) <= 0xFFFF:
+        header += bytes([126]) + struct.pack(">H", len(payload))
+    else:
+        header += bytes([127]) + struct.pack(">Q", len(payload))
+    conn.sendall(header + payload)
+
+
+def recv_message(conn):
+    first, second = recv_exact(conn, 2)
+    if not second & 0x80:
+        fail("client frames must be masked")
+    size = second & 0x7F
+    if size == 126:
+        size = struct.unpack(">H", recv_exact(conn, 2))[0]
+    elif size == 127:
+        size = struct.unpack(">Q", recv_exact(conn, 8))[0]
+    mask = recv_exact(conn, 4)
+    payload = bytes(b ^ mask[i % 4] for i, b in enumerate(recv_exact(conn, size)))
+    if first & 0x0F != 0x2 or not first & 0x80:
+        fail(f"expected a single binary frame, got opcode {first & 0x0F}")
+    return payload
+
+
+def position(block_num):
+    return struct.pack("<I", block_num) + block_num.to_bytes(32, "little")
+
+
+def main():
+    deltas_path, port_path = sys.argv[1:3]
+    data = open(deltas_path, "rb").read()
+    frames, pos = [], 0
+    while pos < len(data):
+        (size,) = struct.unpack_from("<I", data, pos)
+        frames.append(data[pos + 4 : pos + 4 + size])
+        pos += 4 + size
+    head = len(frames)
+
+    server = socket.socket()
+    server.bind(("127.0.0.1", 0))
+    server.listen(1)
+    server.settimeout(30)
+    with open(port_path, "w") as out:
+        out.write(str(server.getsockname()[1]))
+    conn, _ = server.accept()
+    conn.settimeout(30)
+
+    request = b""
+    while not request.endswith(b"\r\n\r\n"):
+        request += recv_exact(conn, 1)
+    key = next(line.split(b":", 1)[1].strip() for line in request.split(b"\r\n") if line.lower().startswith(b"sec-websocket-key:"))
+    accept = base64.b64encode(hashlib.sha1(key + GUID).digest())
+    conn.sendall(b"HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                 b"Sec-WebSocket-Accept: " + accept + b"\r\n\r\n")
+    send_message(conn, b'{"version":"eosio::abi/1.1"}', opcode=0x1)
+
+    if recv_message(conn) != varuint(0):
+        fail("expected get_status_request_v0 first")
+    # get_status_result_v0: head, last_irreversible, trace and chain state block ranges
+    send_message(conn, varuint(0) + position(head) + position(head) + struct.pack("<IIII", 1, head + 1, 1, head + 1))
+
+    message = recv_message(conn)
+    variant, pos = read_varuint(message, 0)
+    if variant != 1:
+        fail("expected get_blocks_request_v0")
+    start, end, in_flight = struct.unpack_from("<III", message, pos)
+    positions, pos = read_varuint(message, pos + 12)
+    irreversible_only, fetch_block, fetch_traces, fetch_deltas = message[pos : pos + 4]
+    if start != 1 or positions != 0:
+        fail(f"expected to start at chain_state_begin_block 1, got {start}")
+    if not (irreversible_only and fetch_deltas) or fetch_block or fetch_traces:
+        fail("expected irreversible deltas only")
+
+    unacked = 0
+    for block in range(start, min(end, head + 1)):
+        while unacked >= in_flight:
+            ack = recv_message(conn)
+            variant, pos = read_varuint(ack, 0)
+            if variant != 2:
+                fail("expected get_blocks_ack_request_v0")
+            unacked -= struct.unpack_from("<I", ack, pos)[0]
+        # get_blocks_result_v0 with this_block, prev_block and deltas set
+        send_message(conn, varuint(1) + position(head) + position(head) + b"\x01" + position(block) +
+                     b"\x01" + position(block - 1) + b"\x00" + b"\x00" + b"\x01" + varuint(len(frames[block - 1])) +
+                     frames[block - 1])
+        unacked += 1
+
+    try:
+        send_message(conn, b"", opcode=0x8)
+    except OSError:
+        pass  # the client already has what it asked for and may have gone
+    conn.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,396 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "../common/mirror_rows.hpp"
+using namespace mirror_tools;
+
+/*
+ * Mirror Transaction Packer
+ * ----------------
+ * Turns an onboarding manifest into the fewest transactions that fit a per-transaction
+ * CPU / NET budget, instead of pushing every `setup`, deposit and `mint` on its own.
+ *
+ * Manifest (one operation per line, `#` starts a comment):
+ *   setup   <creator> <synth symbol> <base symbol>    e.g. setup creator 4,SYNTH 4,BASE
+ *   mint    <creator> <synth ticker> <deposit>        e.g. mint creator SYNTH 100.0000 BASE
+ *   migrate <actor> <limit>                           e.g. migrate creator 50
+ * `mint` is the totems `transfer` of the deposit to the mirror followed by the totems `mint`
+ * that picks it up; the two always land in the same transaction, so no other deposit can
+ * be counted in between.
+ *
+ * Cost model:
+ *   - CPU per operation comes from `tests/mirror.bench.ts` output (`--costs bench_output.txt`):
+ *     `setup` uses the `setup` case, `mint` the `deposit` + `mint` cases, read from
+ *     `--cost-field` (default p99_us, so a full transaction still fits on a slow run).
+ *     A case with too few `runs=` for that field (under 100 for p99_us) is refused.
+ *     `migrate` is `--migrate-row-us` per row. Each transaction adds `--tx-overhead-us`.
+ *   - NET is the packed transaction size, plus one 66 byte signature per distinct actor and
+ *     the 12 byte per-transaction base, rounded up to 8 byte words as the chain bills it.
+ *
+ * Operations are never reordered (a mint needs its pairing set up first), so packing them
+ * greedily, closing a transaction only when the next operation doesn't fit, gives the fewest
+ * transactions.
+ *
+ * Output: <out>/tx_0001.json, ... unsigned transactions with empty TaPoS fields, in the form
+ * `cleos push transaction` takes (it fills in TaPoS and signs), plus the plan on stdout.
+ *
+ * usage: tx_packer --manifest <file> --out <dir> [--costs <bench output>] [--cost-field mean_us|p50_us|p99_us]
+ *                  [--cpu-us N] [--net-bytes N] [--tx-overhead-us N] [--migrate-row-us N]
+ *                  [--mirror <account>] [--totems <account>] [--payment <symbol>]
+ * ----------------
+ */
+
+/* ---------------- ACTIONS ---------------- */
+
+struct Action {
+    std::string account;
+    std::string name;
+    std::string actor;
+    // Packed action data and the same arguments as a JSON object
+    std::string data;
+    std::string json;
+};
+
+struct Operation {
+    int line = 0;
+    std::string kind;
+    std::vector<Action> actions;
+    double cpu_us = 0;
+};
+
+struct Config {
+    // The deployed mirror account, as in ship_consumer
+    std::string mirror = "mirrormirror";
+    std::string totems = "totemstotems";
+    // Totems `mint` takes a payment, which the mirror mod requires to be zero
+    Asset payment = parse_symbol("4,A");
+};
+
+static std::string quoted(const std::string& str) { return "\"" + str + "\""; }
+
+static std::string symbol_string(const Asset& symbol) {
+    return std::to_string(symbol.precision) + "," + symbol_code_to_string(symbol.code);
+}
+
+static Action make_setup(const Config& config, const std::string& creator, const Asset& synth, const Asset& base) {
+    Writer w;
+    w.write(synth.symbol_raw());
+    w.write(base.symbol_raw());
+    return Action{config.mirror, "setup", creator, w.data,
+                  "{\"synth_ticker\":" + quoted(symbol_string(synth)) + ",\"base_ticker\":" + quoted(symbol_string(base)) + "}"};
+}
+
+static Action make_transfer(const Config& config, const std::string& from, const std::string& to, const Asset& quantity) {
+    Writer w;
+    w.write(name_from_string(from));
+    w.write(name_from_string(to));
+    w.write_asset(quantity);
+    w.write_bytes("");
+    return Action{config.totems, "transfer", from, w.data,
+                  "{\"from\":" + quoted(from) + ",\"to\":" + quoted(to) + ",\"quantity\":" + quoted(format_asset(quantity)) +
+                      ",\"memo\":\"\"}"};
+}
+
+static Action make_mint(const Config& config, const std::string& minter, const Asset& quantity) {
+    Writer w;
+    w.write(name_from_string(config.mirror));
+    w.write(name_from_string(minter));
+    w.write_asset(quantity);
+    w.write_asset(config.payment);
+    w.write_bytes("");
+    return Action{config.totems, "mint", minter, w.data,
+                  "{\"mod\":" + quoted(config.mirror) + ",\"minter\":" + quoted(minter) + ",\"quantity\":" +
+                      quoted(format_asset(quantity)) + ",\"payment\":" + quoted(format_asset(config.payment)) + ",\"memo\":\"\"}"};
+}
+
+static Action make_migrate(const Config& config, const std::string& actor, uint32_t limit) {
+    Writer w;
+    w.write(limit);
+    return Action{config.mirror, "migrate", actor, w.data, "{\"limit\":" + std::to_string(limit) + "}"};
+}
+
+/* ---------------- COST MODEL ---------------- */
+
+struct CostModel {
+    // Uncalibrated fallbacks, replaced by the bench cases of the same name
+    std::map<std::string, double> case_us{{"setup", 400}, {"deposit", 200}, {"mint", 500}};
+    double migrate_row_us = 60;
+    double tx_overhead_us = 100;
+    bool calibrated = false;
+
+    // Reads `bench <case> runs=<n> mean_us=<x> p50_us=<y> p99_us=<z>` lines, ignoring anything else
+    void load(const std::string& path, const std::string& field) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("Cannot open " + path);
+        std::string line;
+        while (std::getline(in, line)) {
+            auto start = line.find("bench ");
+            if (start == std::string::npos) continue;
+            std::istringstream tokens(line.substr(start + 6));
+            std::string label, token;
+            tokens >> label;
+            long runs = 0;
+            std::optional<double> value;
+            while (tokens >> token) {
+                auto eq = token.find('=');
+                if (eq == std::string::npos) continue;
+                if (token.substr(0, eq) == "runs") runs = std::stol(token.substr(eq + 1));
+                else if (token.substr(0, eq) == field) value = std::stod(token.substr(eq + 1));
+            }
+            if (!value) continue;
+            if (runs < min_runs(field)) {
+                throw std::runtime_error("Bench case " + label + " has runs=" + std::to_string(runs) + ", " + field +
+                                         " needs at least " + std::to_string(min_runs(field)));
+            }
+            case_us[label] = *value;
+            calibrated = true;
+        }
+    }
+
+    // A percentile from fewer than 1 / (1 - p) samples is just the slowest one seen
+    static long min_runs(const std::string& field) {
+        if (field == "p99_us") return 100;
+        if (field == "p50_us") return 2;
+        return 1;
+    }
+
+    double get(const std::string& label) const {
+        auto it = case_us.find(label);
+        if (it == case_us.end()) throw std::runtime_error("No cost for bench case " + label);
+        return it->second;
+    }
+};
+
+/* ---------------- MANIFEST ---------------- */
+
+static std::vector<Operation> parse_manifest(const std::string& path, const Config& config, const CostModel& costs) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+
+    std::vector<Operation> ops;
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        auto comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream tokens(line);
+        std::vector<std::string> args;
+        for (std::string token; tokens >> token;) args.push_back(token);
+        if (args.empty()) continue;
+
+        auto fail = [&](const std::string& message) {
+            throw std::runtime_error(path + ":" + std::to_string(number) + ": " + message);
+        };
+
+        Operation op;
+        op.line = number;
+        op.kind = args[0];
+        try {
+            if (args[0] == "setup" && args.size() == 4) {
+                Asset synth = parse_symbol(args[2]);
+                Asset base = parse_symbol(args[3]);
+                op.actions.push_back(make_setup(config, args[1], synth, base));
+                op.cpu_us = costs.get("setup");
+            } else if (args[0] == "mint" && args.size() == 5) {
+                Asset deposit = parse_asset(args[3] + " " + args[4]);
+                if (deposit.amount <= 0) fail("Deposit must be positive");
+                // The contract mints whatever was deposited, `quantity` only names the synth
+                Asset synth{0, deposit.precision, symbol_code_from_string(args[2])};
+                op.actions.push_back(make_transfer(config, args[1], config.mirror, deposit));
+                op.actions.push_back(make_mint(config, args[1], synth));
+                op.cpu_us = costs.get("deposit") + costs.get("mint");
+            } else if (args[0] == "migrate" && args.size() == 3) {
+                long limit = std::atol(args[2].c_str());
+                if (limit <= 0) fail("Limit must be positive");
+                op.actions.push_back(make_migrate(config, args[1], uint32_t(limit)));
+                op.cpu_us = costs.migrate_row_us * double(limit);
+            } else {
+                fail("Unrecognized operation: " + line);
+            }
+            for (auto& action : op.actions) name_from_string(action.actor);
+        } catch (const std::runtime_error& e) {
+            if (std::string(e.what()).rfind(path + ":", 0) == 0) throw;
+            fail(e.what());
+        }
+        ops.push_back(std::move(op));
+    }
+    return ops;
+}
+
+/* ---------------- PACKING ---------------- */
+
+struct Transaction {
+    std::vector<const Operation*> ops;
+    double cpu_us = 0;
+    size_t net_bytes = 0;
+    std::set<std::string> actors;
+};
+
+static size_t varuint32_size(size_t value) {
+    size_t size = 1;
+    for (; value >= 0x80; value >>= 7) size++;
+    return size;
+}
+
+// account + name + one permission_level + data
+static size_t packed_action_size(const Action& action) {
+    return 8 + 8 + varuint32_size(1) + 16 + varuint32_size(action.data.size()) + action.data.size();
+}
+
+static size_t net_bytes(const std::vector<const Operation*>& ops, size_t actor_count) {
+    size_t actions = 0;
+    size_t size = 0;
+    for (auto* op : ops) {
+        for (auto& action : op->actions) {
+            size += packed_action_size(action);
+            actions++;
+        }
+    }
+    // expiration, ref_block_num, ref_block_prefix, max_net_usage_words, max_cpu_usage_ms, delay_sec,
+    // context_free_actions, actions, transaction_extensions
+    size += 4 + 2 + 4 + 1 + 1 + 1 + 1 + varuint32_size(actions) + 1;
+    // signatures and the chain's base_per_transaction_net_usage
+    size += varuint32_size(actor_count) + 66 * actor_count + 12;
+    return (size + 7) / 8 * 8;
+}
+
+static std::vector<Transaction> pack(const std::vector<Operation>& ops, const CostModel& costs, double cpu_budget, size_t net_budget) {
+    std::vector<Transaction> txs;
+    Transaction current;
+
+    auto with = [&](const Transaction& tx, const Operation& op) {
+        Transaction next = tx;
+        next.ops.push_back(&op);
+        next.cpu_us += op.cpu_us;
+        for (auto& action : op.actions) next.actors.insert(action.actor);
+        next.net_bytes = net_bytes(next.ops, next.actors.size());
+        return next;
+    };
+    auto fits = [&](const Transaction& tx) { return costs.tx_overhead_us + tx.cpu_us <= cpu_budget && tx.net_bytes <= net_budget; };
+
+    for (auto& op : ops) {
+        Transaction next = with(current, op);
+        if (fits(next)) {
+            current = std::move(next);
+            continue;
+        }
+        if (current.ops.empty()) {
+            throw std::runtime_error("Operation on line " + std::to_string(op.line) + " alone exceeds the transaction budget");
+        }
+        txs.push_back(std::move(current));
+        current = with(Transaction{}, op);
+        if (!fits(current)) {
+            throw std::runtime_error("Operation on line " + std::to_string(op.line) + " alone exceeds the transaction budget");
+        }
+    }
+    if (!current.ops.empty()) txs.push_back(std::move(current));
+    for (auto& tx : txs) tx.cpu_us += costs.tx_overhead_us;
+    return txs;
+}
+
+/* ---------------- OUTPUT ---------------- */
+
+static std::string transaction_json(const Transaction& tx) {
+    std::string out = "{\n"
+                      "  \"expiration\": \"1970-01-01T00:00:00\",\n"
+                      "  \"ref_block_num\": 0,\n"
+                      "  \"ref_block_prefix\": 0,\n"
+                      "  \"max_net_usage_words\": 0,\n"
+                      "  \"max_cpu_usage_ms\": 0,\n"
+                      "  \"delay_sec\": 0,\n"
+                      "  \"context_free_actions\": [],\n"
+                      "  \"actions\": [";
+    bool first = true;
+    for (auto* op : tx.ops) {
+        for (auto& action : op->actions) {
+            out += first ? "\n" : ",\n";
+            first = false;
+            out += "    {\"account\": " + quoted(action.account) + ", \"name\": " + quoted(action.name) +
+                   ", \"authorization\": [{\"actor\": " + quoted(action.actor) + ", \"permission\": \"active\"}]" +
+                   ", \"data\": " + action.json + ", \"hex_data\": " + quoted(to_hex(action.data)) + "}";
+        }
+    }
+    out += "\n  ],\n  \"transaction_extensions\": []\n}\n";
+    return out;
+}
+
+static int usage() {
+    std::fprintf(stderr,
+                 "usage: tx_packer --manifest <file> --out <dir> [--costs <bench output>] [--cost-field mean_us|p50_us|p99_us]\n"
+                 "                 [--cpu-us N] [--net-bytes N] [--tx-overhead-us N] [--migrate-row-us N]\n"
+                 "                 [--mirror <account>] [--totems <account>] [--payment <symbol>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string manifest_path, out_dir, costs_path, cost_field = "p99_us";
+    double cpu_budget = 10000;
+    size_t net_budget = 4096;
+    Config config;
+    CostModel costs;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) return usage();
+            if (arg == "--manifest") manifest_path = argv[++i];
+            else if (arg == "--out") out_dir = argv[++i];
+            else if (arg == "--costs") costs_path = argv[++i];
+            else if (arg == "--cost-field") cost_field = argv[++i];
+            else if (arg == "--cpu-us") cpu_budget = std::atof(argv[++i]);
+            else if (arg == "--net-bytes") net_budget = size_t(std::atol(argv[++i]));
+            else if (arg == "--tx-overhead-us") costs.tx_overhead_us = std::atof(argv[++i]);
+            else if (arg == "--migrate-row-us") costs.migrate_row_us = std::atof(argv[++i]);
+            else if (arg == "--mirror") config.mirror = argv[++i];
+            else if (arg == "--totems") config.totems = argv[++i];
+            else if (arg == "--payment") config.payment = parse_symbol(argv[++i]);
+            else return usage();
+        }
+        if (manifest_path.empty() || out_dir.empty()) return usage();
+        name_from_string(config.mirror);
+        name_from_string(config.totems);
+
+        if (!costs_path.empty()) {
+            costs.load(costs_path, cost_field);
+            if (!costs.calibrated) throw std::runtime_error("No `" + cost_field + "` bench results in " + costs_path);
+        } else {
+            std::fprintf(stderr, "tx_packer: no --costs given, using uncalibrated CPU estimates\n");
+        }
+
+        auto ops = parse_manifest(manifest_path, config, costs);
+        auto txs = pack(ops, costs, cpu_budget, net_budget);
+
+        ::mkdir(out_dir.c_str(), 0755);
+        std::printf("%-12s %5s %8s %10s %10s  %s\n", "file", "ops", "actions", "cpu_us", "net_bytes", "signers");
+        size_t action_count = 0;
+        for (size_t i = 0; i < txs.size(); ++i) {
+            char file[32];
+            std::snprintf(file, sizeof(file), "tx_%04zu.json", i + 1);
+            std::ofstream out(out_dir + "/" + file);
+            if (!out) throw std::runtime_error("Cannot write " + out_dir + "/" + file);
+            out << transaction_json(txs[i]);
+
+            size_t actions = 0;
+            for (auto* op : txs[i].ops) actions += op->actions.size();
+            action_count += actions;
+            std::string signers;
+            for (auto& actor : txs[i].actors) signers += (signers.empty() ? "" : ",") + actor;
+            std::printf("%-12s %5zu %8zu %10.0f %10zu  %s\n", file, txs[i].ops.size(), actions, txs[i].cpu_us,
+                        txs[i].net_bytes, signers.c_str());
+        }
+        std::printf("\n%zu operations (%zu actions) packed into %zu transactions (budget %.0f us, %zu bytes)\n", ops.size(),
+                    action_count, txs.size(), cpu_budget, net_budget);
+        return 0;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "tx_packer: %s\n", e.what());
+        return 2;
+    }
+}